@@ -0,0 +1,106 @@
+// Times sdl::convert_pixels against SDL_ConvertPixels for every format pair
+// with a vector kernel, and checks that both produce the same bytes.
+//
+//     sdlw-benchmark [width height [runs]]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <SDL2/SDL_log.h>
+
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/surface.hpp>
+
+#include "sdlw/detail/simd.hpp"
+
+namespace {
+
+using sdl::pixel_format_type;
+
+constexpr pixel_format_type formats[] = {
+    pixel_format_type::rgb24,
+    pixel_format_type::bgr24,
+    pixel_format_type::rgba32,
+    pixel_format_type::argb8888,
+    pixel_format_type::rgb565,
+};
+
+template<typename Convert>
+auto best_of(int runs, Convert&& convert) -> double
+{
+    auto best = std::chrono::duration<double, std::milli>::max();
+    for (auto i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        convert();
+        best = std::min<decltype(best)>(best, std::chrono::steady_clock::now() - start);
+    }
+    return best.count();
+}
+
+auto level_name() -> const char*
+{
+    switch (sdl::detail::simd_support()) {
+    case sdl::detail::simd_level::avx2: return "AVX2";
+    case sdl::detail::simd_level::ssse3: return "SSSE3";
+    default: return "none (SDL fallback)";
+    }
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    const auto width = argc > 2 ? std::atoi(argv[1]) : 1920;
+    const auto height = argc > 2 ? std::atoi(argv[2]) : 1080;
+    const auto runs = argc > 3 ? std::atoi(argv[3]) : 50;
+    if (width <= 0 || height <= 0 || runs <= 0) {
+        SDL_Log("usage: %s [width height [runs]]", argv[0]);
+        return 1;
+    }
+
+    SDL_Log("%dx%d, best of %d runs, kernels: %s", width, height, runs, level_name());
+    SDL_Log("%-24s %-24s %10s %10s %8s", "from", "to", "SDL ms", "sdlw ms", "speedup");
+
+    auto rng = std::mt19937{42};
+    auto mismatches = 0;
+    for (const auto from : formats) {
+        const auto src_pitch = width * SDL_BYTESPERPIXEL(static_cast<Uint32>(from));
+        auto src = std::vector<sdl::u8>(static_cast<std::size_t>(src_pitch) * static_cast<std::size_t>(height));
+        std::generate(src.begin(), src.end(), [&] { return static_cast<sdl::u8>(rng()); });
+
+        for (const auto to : formats) {
+            if (from == to) continue;
+            const auto dst_pitch = width * SDL_BYTESPERPIXEL(static_cast<Uint32>(to));
+            const auto dst_size = static_cast<std::size_t>(dst_pitch) * static_cast<std::size_t>(height);
+            auto expected = std::vector<sdl::u8>(dst_size);
+            auto actual = std::vector<sdl::u8>(dst_size);
+
+            const auto sdl_ms = best_of(runs, [&] {
+                SDL_ConvertPixels(
+                    width, height, static_cast<Uint32>(from), src.data(), src_pitch,
+                    static_cast<Uint32>(to), expected.data(), dst_pitch);
+            });
+            const auto sdlw_ms = best_of(runs, [&] {
+                static_cast<void>(sdl::convert_pixels(
+                    width, height, from, src.data(), src_pitch, to, actual.data(), dst_pitch, std::nothrow));
+            });
+
+            const auto same = std::memcmp(expected.data(), actual.data(), dst_size) == 0;
+            mismatches += !same;
+            SDL_Log(
+                "%-24s %-24s %10.3f %10.3f %7.2fx%s",
+                SDL_GetPixelFormatName(static_cast<Uint32>(from)),
+                SDL_GetPixelFormatName(static_cast<Uint32>(to)),
+                sdl_ms,
+                sdlw_ms,
+                sdl_ms / sdlw_ms,
+                same ? "" : "  MISMATCH");
+        }
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/surface.hpp>
+
+namespace sdl {
+
+// Bottom-left skyline rectangle packer.
+class skyline_packer {
+public:
+    skyline_packer() = default;
+
+    explicit skyline_packer(const sdl::size& bin_size)
+    {
+        reset(bin_size);
+    }
+
+    void reset(const sdl::size& bin_size)
+    {
+        _size = bin_size;
+        _used_area = 0;
+        _skyline.clear();
+        _skyline.push_back(node{0, 0, bin_size.w});
+    }
+
+    auto bin_size() const noexcept -> sdl::size
+    {
+        return _size;
+    }
+
+    auto used_area() const noexcept -> long long
+    {
+        return _used_area;
+    }
+
+    auto occupancy() const noexcept -> float
+    {
+        const auto total = static_cast<long long>(_size.w) * _size.h;
+        return total > 0 ? static_cast<float>(_used_area) / static_cast<float>(total) : 0.0f;
+    }
+
+    auto insert(const sdl::size& sz) -> std::optional<point>
+    {
+        if (sz.w <= 0 || sz.h <= 0) {
+            return std::nullopt;
+        }
+        auto best_index = _skyline.size();
+        auto best_bottom = std::numeric_limits<int>::max();
+        auto best_width = std::numeric_limits<int>::max();
+        auto best_y = 0;
+        for (auto i = std::size_t{0}; i != _skyline.size(); ++i) {
+            if (const auto y = fit(i, sz)) {
+                const auto bottom = *y + sz.h;
+                if (bottom < best_bottom || (bottom == best_bottom && _skyline[i].w < best_width)) {
+                    best_index = i;
+                    best_bottom = bottom;
+                    best_width = _skyline[i].w;
+                    best_y = *y;
+                }
+            }
+        }
+        if (best_index == _skyline.size()) {
+            return std::nullopt;
+        }
+        const auto position = point{_skyline[best_index].x, best_y};
+        add_level(best_index, rect{position.x, position.y, sz.w, sz.h});
+        _used_area += static_cast<long long>(sz.w) * sz.h;
+        return position;
+    }
+
+private:
+    struct node {
+        int x;
+        int y;
+        int w;
+    };
+
+    auto fit(std::size_t index, const sdl::size& sz) const -> std::optional<int>
+    {
+        const auto x = _skyline[index].x;
+        if (x + sz.w > _size.w) {
+            return std::nullopt;
+        }
+        auto width_left = sz.w;
+        auto y = _skyline[index].y;
+        for (auto i = index; width_left > 0; ++i) {
+            y = std::max(y, _skyline[i].y);
+            if (y + sz.h > _size.h) {
+                return std::nullopt;
+            }
+            width_left -= _skyline[i].w;
+        }
+        return y;
+    }
+
+    void add_level(std::size_t index, const rect& r)
+    {
+        _skyline.insert(_skyline.begin() + index, node{r.x, r.y + r.h, r.w});
+        for (auto i = index + 1; i < _skyline.size();) {
+            const auto& prev = _skyline[i - 1];
+            auto& cur = _skyline[i];
+            if (cur.x >= prev.x + prev.w) {
+                break;
+            }
+            const auto shrink = prev.x + prev.w - cur.x;
+            cur.x += shrink;
+            cur.w -= shrink;
+            if (cur.w > 0) {
+                break;
+            }
+            _skyline.erase(_skyline.begin() + i);
+        }
+        for (auto i = std::size_t{1}; i < _skyline.size();) {
+            if (_skyline[i - 1].y == _skyline[i].y) {
+                _skyline[i - 1].w += _skyline[i].w;
+                _skyline.erase(_skyline.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    std::vector<node> _skyline;
+    sdl::size _size = {0, 0};
+    long long _used_area = 0;
+};
+
+// Packs surfaces into a small number of ARGB8888 pages. Inserted images are
+// addressed by id; operator[] yields a sub_texture that renderer::copy
+// accepts directly. A repack moves images, so re-fetch sub_textures after
+// insert() or repack() instead of caching them across those calls.
+class atlas {
+public:
+    using id = std::size_t;
+
+    explicit atlas(renderer& r, const sdl::size& page_size = {2048, 2048}, int padding = 1)
+        : _renderer{r}
+        , _page_size{page_size}
+        , _padding{padding}
+        , _format{pixel_format_type::argb8888}
+    {
+        const auto max_size = r.info().max_texture_size();
+        if (max_size.w > 0) _page_size.w = std::min(_page_size.w, max_size.w);
+        if (max_size.h > 0) _page_size.h = std::min(_page_size.h, max_size.h);
+    }
+
+    atlas(const atlas&) = delete;
+    auto operator=(const atlas&) -> atlas& = delete;
+
+    auto insert(const surface& s) -> id
+    {
+        const auto sz = s.size();
+        auto image = surface{sz.w + 2 * _padding, sz.h + 2 * _padding, 32, pixel_format_type::argb8888};
+        image.fill(rect{0, 0, image.size().w, image.size().h}, 0);
+        auto converted = s.convert(pixel_format_ref{_format.get_pointer()});
+        converted.set_blend_mode(blend_mode::none);
+        auto dst = rect{_padding, _padding, sz.w, sz.h};
+        blit(converted, image, dst);
+
+        if (image.size().w > _page_size.w || image.size().h > _page_size.h) {
+            set_error("sdl::atlas: image does not fit in an atlas page");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+
+        const auto new_id = _entries.size();
+        _entries.push_back(entry{0, rect{}, std::move(image)});
+        if (!place(_entries.back())) {
+            if (_has_sources && !_pages.empty() && try_repack(_pages.size())) {
+                return new_id;
+            }
+            add_page();
+            place(_entries.back());
+        }
+        upload(_entries.back());
+        if (!_has_sources) {
+            _entries.back().source = std::nullopt;
+        }
+        return new_id;
+    }
+
+    auto operator[](id i) const -> sub_texture
+    {
+        const auto& e = _entries[i];
+        return sub_texture{&_pages[e.page].texture.ref(), e.area};
+    }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return _entries.size();
+    }
+
+    auto page_count() const noexcept -> std::size_t
+    {
+        return _pages.size();
+    }
+
+    auto page(std::size_t index) const noexcept -> const texture&
+    {
+        return _pages[index].texture;
+    }
+
+    auto page_size() const noexcept -> sdl::size
+    {
+        return _page_size;
+    }
+
+    // Repacks every image from scratch, tallest first, adding pages only if
+    // the current ones no longer suffice. Requires the retained sources.
+    void repack()
+    {
+        if (!_has_sources) {
+            set_error("sdl::atlas: cannot repack after release_sources()");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        auto page_count = std::max<std::size_t>(_pages.size(), 1);
+        while (!try_repack(page_count)) {
+            ++page_count;
+        }
+    }
+
+    // Drops the CPU copies kept for repacking. Later inserts only ever
+    // append pages.
+    void release_sources() noexcept
+    {
+        for (auto& e : _entries) {
+            e.source = std::nullopt;
+        }
+        _has_sources = false;
+    }
+
+private:
+    struct page_storage {
+        sdl::texture texture;
+        skyline_packer packer;
+    };
+
+    struct entry {
+        std::size_t page;
+        rect area;
+        std::optional<surface> source;
+    };
+
+    void add_page()
+    {
+        auto t = texture{_renderer, pixel_format_type::argb8888, texture_access::static_, _page_size};
+        t.set_blend_mode(blend_mode::blend);
+        _pages.push_back(page_storage{std::move(t), skyline_packer{_page_size}});
+    }
+
+    auto place(entry& e) -> bool
+    {
+        const auto sz = e.source->size();
+        for (auto i = std::size_t{0}; i != _pages.size(); ++i) {
+            if (const auto pos = _pages[i].packer.insert(sz)) {
+                e.page = i;
+                e.area = rect{pos->x + _padding, pos->y + _padding, sz.w - 2 * _padding, sz.h - 2 * _padding};
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void upload(const entry& e)
+    {
+        const auto& src = *e.source;
+        const auto sz = src.size();
+        const auto area = rect{e.area.x - _padding, e.area.y - _padding, sz.w, sz.h};
+        _pages[e.page].texture.update(area, src.pixels(), src.pitch());
+    }
+
+    auto try_repack(std::size_t page_count) -> bool
+    {
+        auto order = std::vector<std::size_t>(_entries.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t lhs, std::size_t rhs) {
+            return _entries[lhs].source->size().h > _entries[rhs].source->size().h;
+        });
+
+        auto packers = std::vector<skyline_packer>(page_count, skyline_packer{_page_size});
+        auto placements = std::vector<std::pair<std::size_t, point>>(_entries.size());
+        for (const auto i : order) {
+            const auto sz = _entries[i].source->size();
+            auto placed = false;
+            for (auto p = std::size_t{0}; p != packers.size() && !placed; ++p) {
+                if (const auto pos = packers[p].insert(sz)) {
+                    placements[i] = {p, *pos};
+                    placed = true;
+                }
+            }
+            if (!placed) {
+                return false;
+            }
+        }
+
+        while (_pages.size() < page_count) {
+            add_page();
+        }
+        for (auto p = std::size_t{0}; p != page_count; ++p) {
+            _pages[p].packer = packers[p];
+        }
+        for (auto i = std::size_t{0}; i != _entries.size(); ++i) {
+            auto& e = _entries[i];
+            const auto sz = e.source->size();
+            const auto [p, pos] = placements[i];
+            e.page = p;
+            e.area = rect{pos.x + _padding, pos.y + _padding, sz.w - 2 * _padding, sz.h - 2 * _padding};
+            upload(e);
+        }
+        return true;
+    }
+
+    renderer& _renderer;
+    sdl::size _page_size;
+    int _padding;
+    pixel_format _format;
+    std::deque<page_storage> _pages;
+    std::vector<entry> _entries;
+    bool _has_sources = true;
+};
+
+} // namespace sdl
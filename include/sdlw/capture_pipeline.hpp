@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sdlw/error.hpp>
+#include <sdlw/image.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/rwops.hpp>
+#include <sdlw/surface.hpp>
+
+namespace sdl {
+
+// clang-format off
+
+enum class capture_format {
+    png, // one <path><6-digit frame number>.png per frame
+    raw, // ARGB8888 frames appended to <path>, rows tightly packed
+    y4m  // 4:2:0 YUV4MPEG2 stream in <path>
+};
+
+// What capture() does when every buffer is still being encoded.
+enum class capture_overflow {
+    drop, // skip the frame and count it in capture_stats::dropped
+    wait  // block the render thread until a buffer frees up
+};
+
+// clang-format on
+
+struct capture_options {
+    capture_format format = capture_format::png;
+    capture_overflow overflow = capture_overflow::drop;
+    int buffer_count = 4;
+    int worker_count = 2;
+    int frame_rate = 60; // only written to the Y4M header
+};
+
+struct capture_stats {
+    u64 captured = 0; // frames read back and queued
+    u64 dropped = 0;  // frames skipped because no buffer was free
+    u64 written = 0;  // frames encoded and stored
+    u64 failed = 0;   // frames lost to a readback, encoding or I/O error
+};
+
+// Reads renderer frames into a ring of preallocated buffers and encodes them
+// on a pool of worker threads. SDL2 has no asynchronous readback, so the
+// render thread still pays for read_pixels(), but never for encoding or
+// disk I/O. Raw and Y4M frames are written in capture order whatever the
+// worker count. Destroying the pipeline finishes every queued frame.
+class capture_pipeline {
+public:
+    capture_pipeline(const sdl::size& frame_size, std::string path, const capture_options& options = {})
+        : _size{frame_size}
+        , _path{std::move(path)}
+        , _options{options}
+    {
+        if (_size.w <= 0 || _size.h <= 0) {
+            set_error("sdl::capture_pipeline: empty frame size");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        if (_options.format == capture_format::y4m && (_size.w % 2 != 0 || _size.h % 2 != 0)) {
+            set_error("sdl::capture_pipeline: Y4M frames need an even width and height");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        const auto buffer_count = static_cast<std::size_t>(std::max(_options.buffer_count, 1));
+        const auto frame_bytes = static_cast<std::size_t>(pitch()) * static_cast<std::size_t>(_size.h);
+        _slots.resize(buffer_count);
+        for (auto i = std::size_t{0}; i < buffer_count; ++i) {
+            _slots[i].pixels.resize(frame_bytes);
+            if (_options.format == capture_format::y4m) {
+                _slots[i].encoded.resize(frame_bytes * 3 / 8);
+            }
+            _free.push_back(i);
+        }
+        if (_options.format != capture_format::png) {
+            open_output();
+        }
+
+        // Threads start last, so nothing after them can throw and destroy
+        // them while joinable; if one fails to start, the others are
+        // stopped and the output closed before rethrowing.
+        const auto worker_count = std::max(_options.worker_count, 1);
+#if !defined(SDLW_NO_EXCEPTIONS)
+        try {
+#endif
+            for (auto i = 0; i < worker_count; ++i) {
+                _workers.emplace_back([this] { work(); });
+            }
+#if !defined(SDLW_NO_EXCEPTIONS)
+        } catch (...) {
+            shut_down();
+            throw;
+        }
+#endif
+    }
+
+    capture_pipeline(const capture_pipeline&) = delete;
+    auto operator=(const capture_pipeline&) -> capture_pipeline& = delete;
+
+    ~capture_pipeline()
+    {
+        shut_down();
+    }
+
+    // Reads the current render target into a free buffer and queues it.
+    // Call it on the render thread before present(). Returns false when the
+    // frame was dropped or the readback failed.
+    auto capture(const renderer& r) -> bool
+    {
+        auto index = std::size_t{0};
+        {
+            auto lock = std::unique_lock{_mutex};
+            if (_free.empty()) {
+                if (_options.overflow == capture_overflow::drop) {
+                    ++_stats.dropped;
+                    return false;
+                }
+                _slot_freed.wait(lock, [this] { return !_free.empty(); });
+            }
+            index = _free.back();
+            _free.pop_back();
+        }
+
+        auto& s = _slots[index];
+        const auto area = rect{0, 0, _size.w, _size.h};
+        const auto read = r.read_pixels(s.pixels.data(), area, pixel_format_type::argb8888, pitch(), std::nothrow);
+        {
+            const auto lock = std::lock_guard{_mutex};
+            if (!read) {
+                ++_stats.failed;
+                _free.push_back(index);
+                return false;
+            }
+            s.sequence = _next_sequence++;
+            ++_stats.captured;
+            _queue.push_back(index);
+        }
+        _work_ready.notify_one();
+        return true;
+    }
+
+    // Blocks until every captured frame has been written.
+    void flush()
+    {
+        auto lock = std::unique_lock{_mutex};
+        _slot_freed.wait(lock, [this] { return _free.size() == _slots.size(); });
+    }
+
+    // Frames captured but not yet written.
+    auto pending() const -> std::size_t
+    {
+        const auto lock = std::lock_guard{_mutex};
+        return _slots.size() - _free.size();
+    }
+
+    auto stats() const -> capture_stats
+    {
+        const auto lock = std::lock_guard{_mutex};
+        return _stats;
+    }
+
+    auto frame_size() const noexcept -> sdl::size
+    {
+        return _size;
+    }
+
+    auto options() const noexcept -> const capture_options&
+    {
+        return _options;
+    }
+
+private:
+    struct slot {
+        std::vector<u8> pixels;
+        std::vector<u8> encoded;
+        u64 sequence = 0;
+    };
+
+    auto pitch() const noexcept -> int
+    {
+        return _size.w * 4;
+    }
+
+    // Finishes queued frames, joins the workers and closes the output.
+    void shut_down() noexcept
+    {
+        {
+            const auto lock = std::lock_guard{_mutex};
+            _stopping = true;
+        }
+        _work_ready.notify_all();
+        for (auto& w : _workers) {
+            w.join();
+        }
+        _workers.clear();
+        if (_file) {
+            _file->close();
+            _file.reset();
+        }
+    }
+
+    void open_output()
+    {
+        _file.emplace(_path.c_str(), "wb", std::nothrow);
+        if (!*_file) {
+            _file.reset();
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        if (_options.format == capture_format::y4m) {
+            char header[96];
+            const auto length = std::snprintf(
+                header,
+                sizeof(header),
+                "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n",
+                _size.w,
+                _size.h,
+                std::max(_options.frame_rate, 1));
+            if (_file->write(header, 1, static_cast<std::size_t>(length)) != static_cast<std::size_t>(length)) {
+                _file->close();
+                _file.reset();
+                SDLW_DETAIL_THROW_ERROR();
+            }
+        }
+    }
+
+    void work()
+    {
+        for (;;) {
+            auto index = std::size_t{0};
+            {
+                auto lock = std::unique_lock{_mutex};
+                _work_ready.wait(lock, [this] { return _stopping || !_queue.empty(); });
+                if (_queue.empty()) return;
+                index = _queue.front();
+                _queue.pop_front();
+            }
+
+            auto& s = _slots[index];
+            auto ok = encode(s);
+            if (_file) {
+                // Every frame takes its turn, failed ones included, so a
+                // bad frame cannot stall the ones queued behind it.
+                {
+                    auto lock = std::unique_lock{_mutex};
+                    _write_turn.wait(lock, [&] { return _next_write == s.sequence; });
+                }
+                ok = ok && write(s);
+                {
+                    const auto lock = std::lock_guard{_mutex};
+                    ++_next_write;
+                }
+                _write_turn.notify_all();
+            }
+
+            {
+                const auto lock = std::lock_guard{_mutex};
+                ++(ok ? _stats.written : _stats.failed);
+                _free.push_back(index);
+            }
+            _slot_freed.notify_all();
+        }
+    }
+
+    auto encode(slot& s) const -> bool
+    {
+        switch (_options.format) {
+        case capture_format::png: {
+            char number[24];
+            std::snprintf(number, sizeof(number), "%06llu.png", static_cast<unsigned long long>(s.sequence));
+            const auto image = surface{SDL_CreateRGBSurfaceWithFormatFrom(
+                s.pixels.data(), _size.w, _size.h, 32, pitch(), static_cast<u32>(pixel_format_type::argb8888))};
+            if (!image.get_pointer()) return false;
+            return static_cast<bool>(img::save_as_png(image, (_path + number).c_str(), std::nothrow));
+        }
+        case capture_format::y4m:
+            return static_cast<bool>(convert_pixels(
+                _size.w,
+                _size.h,
+                pixel_format_type::argb8888,
+                s.pixels.data(),
+                pitch(),
+                pixel_format_type::iyuv,
+                s.encoded.data(),
+                _size.w,
+                std::nothrow));
+        default: return true;
+        }
+    }
+
+    // Only called by the worker whose turn it is, so the file needs no lock.
+    auto write(slot& s) -> bool
+    {
+        if (_options.format == capture_format::y4m) {
+            static constexpr char frame_header[] = "FRAME\n";
+            return _file->write(frame_header, 1, sizeof(frame_header) - 1) == sizeof(frame_header) - 1
+                && _file->write(s.encoded.data(), 1, s.encoded.size()) == s.encoded.size();
+        }
+        return _file->write(s.pixels.data(), 1, s.pixels.size()) == s.pixels.size();
+    }
+
+    sdl::size _size;
+    std::string _path;
+    capture_options _options;
+    std::optional<file_stream> _file;
+
+    std::vector<slot> _slots;
+    std::vector<std::size_t> _free;
+    std::deque<std::size_t> _queue;
+    u64 _next_sequence = 0;
+    u64 _next_write = 0;
+    bool _stopping = false;
+    capture_stats _stats;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _work_ready;
+    std::condition_variable _slot_freed;
+    std::condition_variable _write_turn;
+    std::vector<std::thread> _workers;
+};
+
+} // namespace sdl
@@ -20,7 +20,7 @@ struct clipboard {
     static void set_text(const char* text)
     {
         if (SDL_SetClipboardText(text) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 };
@@ -0,0 +1,541 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL2/SDL_render.h>
+
+#include <sdlw/blend_mode.hpp>
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/rwops.hpp>
+
+namespace sdl {
+
+// Records renderer calls into a flat byte stream of POD commands without
+// touching SDL, for later replay against a renderer. Textures are stored as
+// indices into a per-buffer table in first-use order, so two recordings of
+// the same frame compare equal byte for byte. Recorded textures must outlive
+// replay(). The serialized form is native-endian and leaves the texture
+// table unbound; bind_texture() every slot before replaying a loaded buffer.
+class command_buffer {
+public:
+    static constexpr auto no_texture = ~u32{0};
+
+    command_buffer() = default;
+
+    void reset() noexcept
+    {
+        _bytes.clear();
+        _textures.clear();
+        _texture_index.clear();
+        _command_count = 0;
+    }
+
+    auto empty() const noexcept -> bool
+    {
+        return _command_count == 0;
+    }
+
+    auto command_count() const noexcept -> std::size_t
+    {
+        return _command_count;
+    }
+
+    auto byte_size() const noexcept -> std::size_t
+    {
+        return _bytes.size();
+    }
+
+    auto texture_count() const noexcept -> std::size_t
+    {
+        return _textures.size();
+    }
+
+    void bind_texture(std::size_t index, const texture_ref& t)
+    {
+        auto& slot = _textures.at(index);
+        // The texture bound before must not keep recording into this slot.
+        if (const auto old = slot.get_pointer()) {
+            if (const auto it = _texture_index.find(old); it != _texture_index.end() && it->second == index) {
+                _texture_index.erase(it);
+            }
+        }
+        slot = t;
+        if (t.get_pointer()) _texture_index[t.get_pointer()] = static_cast<u32>(index);
+    }
+
+    // Recording
+
+    void clear()
+    {
+        push(op::clear);
+    }
+
+    void set_draw_color(color c)
+    {
+        push(op::set_draw_color, c);
+    }
+
+    void set_draw_blend_mode(blend_mode mode)
+    {
+        push(op::set_draw_blend_mode, static_cast<i32>(mode));
+    }
+
+    // A null texture_ref records a switch back to the default target.
+    void set_target(const texture_ref& t)
+    {
+        push(op::set_target, t.get_pointer() ? texture_slot(t) : no_texture);
+    }
+
+    void set_clip(const rect& r)
+    {
+        push(op::set_clip, r);
+    }
+
+    void set_viewport(const rect& r)
+    {
+        push(op::set_viewport, r);
+    }
+
+    void set_scale(float xscale, float yscale)
+    {
+        push(op::set_scale, scale_args{xscale, yscale});
+    }
+
+    void draw_line(const point& p1, const point& p2)
+    {
+        push(op::draw_line, line_args{p1, p2});
+    }
+
+    void draw_line_strip(span<const point> points)
+    {
+        push_array(op::draw_line_strip, points);
+    }
+
+    void draw_point(const point& p)
+    {
+        push(op::draw_point, p);
+    }
+
+    void draw_points(span<const point> points)
+    {
+        push_array(op::draw_points, points);
+    }
+
+    void draw_rectangle(const rect& r)
+    {
+        push(op::draw_rectangle, r);
+    }
+
+    void draw_rectangles(span<const rect> rectangles)
+    {
+        push_array(op::draw_rectangles, rectangles);
+    }
+
+    void fill_rectangle(const rect& r)
+    {
+        push(op::fill_rectangle, r);
+    }
+
+    void fill_rectangles(span<const rect> rectangles)
+    {
+        push_array(op::fill_rectangles, rectangles);
+    }
+
+    void copy(const texture_ref& t, const rect* src, const rect* dst)
+    {
+        copy(t, src, dst, 0.0, nullptr, renderer_flip::none);
+    }
+
+    void copy(const texture_ref& t, const rect* src, const rect* dst, double angle, const point* center, renderer_flip flip)
+    {
+        auto args = copy_args{};
+        args.texture = texture_slot(t);
+        args.flags = static_cast<u8>((src ? has_src : 0) | (dst ? has_dst : 0) | (center ? has_center : 0));
+        args.flip = static_cast<u8>(flip);
+        if (src) args.src = *src;
+        if (dst) args.dst = *dst;
+        args.angle = angle;
+        if (center) args.center = *center;
+        push(op::copy, args);
+    }
+
+    void copy(const sub_texture& st, const rect* dst)
+    {
+        copy(*st.texture, &st.area, dst);
+    }
+
+    void copy(const sub_texture& st, const rect* dst, double angle, const point* center, renderer_flip flip)
+    {
+        copy(*st.texture, &st.area, dst, angle, center, flip);
+    }
+
+    // Playback
+
+    void replay(renderer& r) const
+    {
+        auto scratch = std::vector<u8>{};
+        for (auto offset = std::size_t{0}; offset != _bytes.size();) {
+            const auto h = load<header>(offset);
+            const auto payload = offset + sizeof(header);
+            execute(r, static_cast<op>(h.code), payload, h.size, scratch);
+            offset = payload + h.size;
+        }
+    }
+
+    // Index of the first command that differs between two recordings, or
+    // nullopt when they are identical. Textures compare by identity.
+    friend auto first_difference(const command_buffer& lhs, const command_buffer& rhs) -> std::optional<std::size_t>
+    {
+        auto lo = std::size_t{0};
+        auto ro = std::size_t{0};
+        auto index = std::size_t{0};
+        for (; lo != lhs._bytes.size() && ro != rhs._bytes.size(); ++index) {
+            const auto lh = lhs.load<header>(lo);
+            const auto rh = rhs.load<header>(ro);
+            const auto length = sizeof(header) + lh.size;
+            if (lh.code != rh.code || lh.size != rh.size || !lhs.same_command(lo, rhs, ro, length)) {
+                return index;
+            }
+            lo += length;
+            ro += length;
+        }
+        if (lo != lhs._bytes.size() || ro != rhs._bytes.size()) {
+            return index;
+        }
+        return std::nullopt;
+    }
+
+    friend auto operator==(const command_buffer& lhs, const command_buffer& rhs) -> bool
+    {
+        return !first_difference(lhs, rhs);
+    }
+
+    friend auto operator!=(const command_buffer& lhs, const command_buffer& rhs) -> bool
+    {
+        return !(lhs == rhs);
+    }
+
+    // Serialization
+
+    void save(stream& s) const
+    {
+        const auto h = file_header{magic, version, static_cast<u32>(_textures.size()), static_cast<u32>(_command_count), _bytes.size()};
+        write_all(s, &h, sizeof(h));
+        write_all(s, _bytes.data(), _bytes.size());
+    }
+
+    static auto load(stream& s) -> command_buffer
+    {
+        auto h = file_header{};
+        read_all(s, &h, sizeof(h));
+        if (h.magic != magic || h.version != version) {
+            set_error("sdl::command_buffer: not a command buffer or unsupported version");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        // Bound the sizes before allocating for them: the stream must hold
+        // the commands, and every texture slot is named by at least one
+        // command, the smallest being a set_target.
+        const auto total = s.size();
+        const auto at = s.tell();
+        const auto truncated = total >= 0 && at >= 0 && h.byte_count > static_cast<u64>(total - at);
+        if (h.byte_count % 4 != 0 || truncated || h.texture_count > h.byte_count / (sizeof(header) + sizeof(u32))) {
+            set_error("sdl::command_buffer: corrupt command stream");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        auto buffer = command_buffer{};
+        buffer._bytes.resize(static_cast<std::size_t>(h.byte_count));
+        read_all(s, buffer._bytes.data(), buffer._bytes.size());
+        buffer._textures.assign(h.texture_count, texture_ref{});
+        buffer._command_count = h.command_count;
+        if (!buffer.is_well_formed()) {
+            set_error("sdl::command_buffer: corrupt command stream");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        return buffer;
+    }
+
+private:
+    // clang-format off
+
+    enum class op : u16 {
+        clear,
+        set_draw_color,
+        set_draw_blend_mode,
+        set_target,
+        set_clip,
+        set_viewport,
+        set_scale,
+        draw_line,
+        draw_line_strip,
+        draw_point,
+        draw_points,
+        draw_rectangle,
+        draw_rectangles,
+        fill_rectangle,
+        fill_rectangles,
+        copy
+    };
+
+    enum copy_flags : u8 {
+        has_src    = 1,
+        has_dst    = 2,
+        has_center = 4
+    };
+
+    // clang-format on
+
+    struct header {
+        u16 code;
+        u16 reserved;
+        u32 size;
+    };
+
+    struct scale_args {
+        float x;
+        float y;
+    };
+
+    struct line_args {
+        point p1;
+        point p2;
+    };
+
+    struct copy_args {
+        u32 texture;
+        u8 flags;
+        u8 flip;
+        u16 reserved;
+        rect src;
+        rect dst;
+        double angle;
+        point center;
+    };
+
+    struct file_header {
+        u32 magic;
+        u32 version;
+        u32 texture_count;
+        u32 command_count;
+        u64 byte_count;
+    };
+
+    static constexpr auto magic = u32{0x42435753}; // "SWCB"
+    static constexpr auto version = u32{1};
+
+    // Payload size of each fixed-size op, or the element size of an array op.
+    static constexpr auto payload_size(op code) noexcept -> std::size_t
+    {
+        switch (code) {
+        case op::clear: return 0;
+        case op::set_draw_color: return sizeof(color);
+        case op::set_draw_blend_mode: return sizeof(i32);
+        case op::set_target: return sizeof(u32);
+        case op::set_clip:
+        case op::set_viewport:
+        case op::draw_rectangle:
+        case op::fill_rectangle:
+        case op::draw_rectangles:
+        case op::fill_rectangles: return sizeof(rect);
+        case op::set_scale: return sizeof(scale_args);
+        case op::draw_line: return sizeof(line_args);
+        case op::draw_point:
+        case op::draw_line_strip:
+        case op::draw_points: return sizeof(point);
+        case op::copy: return sizeof(copy_args);
+        }
+        return 0;
+    }
+
+    static constexpr auto is_array(op code) noexcept -> bool
+    {
+        return code == op::draw_line_strip || code == op::draw_points || code == op::draw_rectangles || code == op::fill_rectangles;
+    }
+
+    // Checks a loaded stream once so that replay() and first_difference()
+    // can trust every header, payload size and texture slot.
+    auto is_well_formed() const noexcept -> bool
+    {
+        auto count = std::size_t{0};
+        for (auto offset = std::size_t{0}; offset != _bytes.size(); ++count) {
+            if (_bytes.size() - offset < sizeof(header)) return false;
+            const auto h = load<header>(offset);
+            const auto payload = offset + sizeof(header);
+            if (h.code > static_cast<u16>(op::copy) || h.size > _bytes.size() - payload) return false;
+            const auto code = static_cast<op>(h.code);
+            const auto element = payload_size(code);
+            if (is_array(code) ? h.size % element != 0 : h.size != element) return false;
+            if (code == op::set_target) {
+                const auto slot = load<u32>(payload);
+                if (slot != no_texture && slot >= _textures.size()) return false;
+            }
+            if (code == op::copy && load<copy_args>(payload).texture >= _textures.size()) return false;
+            offset = payload + h.size;
+        }
+        return count == _command_count;
+    }
+
+    auto texture_slot(const texture_ref& t) -> u32
+    {
+        const auto [it, inserted] = _texture_index.try_emplace(t.get_pointer(), static_cast<u32>(_textures.size()));
+        if (inserted) {
+            _textures.push_back(t);
+        }
+        return it->second;
+    }
+
+    void push(op code, const void* payload, std::size_t size)
+    {
+        const auto h = header{static_cast<u16>(code), 0, static_cast<u32>(size)};
+        const auto offset = _bytes.size();
+        _bytes.resize(offset + sizeof(h) + size);
+        std::memcpy(_bytes.data() + offset, &h, sizeof(h));
+        if (size > 0) {
+            std::memcpy(_bytes.data() + offset + sizeof(h), payload, size);
+        }
+        ++_command_count;
+    }
+
+    void push(op code)
+    {
+        push(code, nullptr, 0);
+    }
+
+    template<typename T>
+    void push(op code, const T& payload)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        push(code, &payload, sizeof(T));
+    }
+
+    template<typename T>
+    void push_array(op code, span<const T> items)
+    {
+        if (!items.data()) {
+            return;
+        }
+        push(code, items.data(), static_cast<std::size_t>(items.size()) * sizeof(T));
+    }
+
+    template<typename T>
+    auto load(std::size_t offset) const noexcept -> T
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto value = T{};
+        std::memcpy(&value, _bytes.data() + offset, sizeof(T));
+        return value;
+    }
+
+    auto texture_at(u32 slot) const -> texture_ref
+    {
+        return slot == no_texture ? texture_ref{} : _textures.at(slot);
+    }
+
+    auto same_command(std::size_t lo, const command_buffer& rhs, std::size_t ro, std::size_t length) const -> bool
+    {
+        if (std::memcmp(_bytes.data() + lo, rhs._bytes.data() + ro, length) != 0) {
+            return false;
+        }
+        const auto code = static_cast<op>(load<header>(lo).code);
+        if (code == op::set_target) {
+            const auto slot = load<u32>(lo + sizeof(header));
+            return texture_at(slot) == rhs.texture_at(slot);
+        }
+        if (code == op::copy) {
+            const auto slot = load<copy_args>(lo + sizeof(header)).texture;
+            return texture_at(slot) == rhs.texture_at(slot);
+        }
+        return true;
+    }
+
+    // Every payload starts at a multiple of 4 bytes, which is all points and
+    // rects need, so arrays are read in place; scratch only serves a
+    // misaligned buffer and is reused across commands.
+    template<typename T>
+    auto load_array(std::size_t offset, u32 size, std::vector<u8>& scratch) const -> span<const T>
+    {
+        auto data = _bytes.data() + offset;
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0) {
+            scratch.resize(size + alignof(T));
+            auto aligned = scratch.data() + (alignof(T) - reinterpret_cast<std::uintptr_t>(scratch.data()) % alignof(T)) % alignof(T);
+            std::memcpy(aligned, data, size);
+            data = aligned;
+        }
+        return span<const T>(reinterpret_cast<const T*>(data), static_cast<std::ptrdiff_t>(size / sizeof(T)));
+    }
+
+    void execute(renderer& r, op code, std::size_t at, u32 size, std::vector<u8>& scratch) const
+    {
+        switch (code) {
+        case op::clear: r.clear(); break;
+        case op::set_draw_color: r.set_draw_color(load<color>(at)); break;
+        case op::set_draw_blend_mode: r.set_draw_blend_mode(static_cast<blend_mode>(load<i32>(at))); break;
+        case op::set_target: {
+            auto t = texture_at(load<u32>(at));
+            r.set_target(t);
+            break;
+        }
+        case op::set_clip: r.set_clip(load<rect>(at)); break;
+        case op::set_viewport: r.set_viewport(load<rect>(at)); break;
+        case op::set_scale: {
+            const auto args = load<scale_args>(at);
+            r.set_scale(args.x, args.y);
+            break;
+        }
+        case op::draw_line: {
+            const auto args = load<line_args>(at);
+            r.draw_line(args.p1, args.p2);
+            break;
+        }
+        case op::draw_line_strip: r.draw_line_strip(load_array<point>(at, size, scratch)); break;
+        case op::draw_point: r.draw_point(load<point>(at)); break;
+        case op::draw_points: r.draw_points(load_array<point>(at, size, scratch)); break;
+        case op::draw_rectangle: r.draw_rectangle(load<rect>(at)); break;
+        case op::draw_rectangles: r.draw_rectangles(load_array<rect>(at, size, scratch)); break;
+        case op::fill_rectangle: r.fill_rectangle(load<rect>(at)); break;
+        case op::fill_rectangles: r.fill_rectangles(load_array<rect>(at, size, scratch)); break;
+        case op::copy: {
+            const auto args = load<copy_args>(at);
+            const auto t = texture_at(args.texture);
+            const auto src = (args.flags & has_src) ? &args.src : nullptr;
+            const auto dst = (args.flags & has_dst) ? &args.dst : nullptr;
+            const auto flip = static_cast<renderer_flip>(args.flip);
+            if (args.angle == 0.0 && flip == renderer_flip::none && !(args.flags & has_center)) {
+                r.copy(t, src, dst);
+            } else {
+                r.copy(t, src, dst, args.angle, (args.flags & has_center) ? &args.center : nullptr, flip);
+            }
+            break;
+        }
+        }
+    }
+
+    static void write_all(stream& s, const void* data, std::size_t size)
+    {
+        if (size > 0 && s.write(data, 1, size) != size) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    static void read_all(stream& s, void* data, std::size_t size)
+    {
+        if (size > 0 && s.read(data, 1, size) != size) {
+            set_error("sdl::command_buffer: unexpected end of stream");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    std::vector<u8> _bytes;
+    std::vector<texture_ref> _textures;
+    std::unordered_map<SDL_Texture*, u32> _texture_index;
+    std::size_t _command_count = 0;
+};
+
+} // namespace sdl
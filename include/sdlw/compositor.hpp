@@ -0,0 +1,363 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <optional>
+
+#include <SDL2/SDL_blendmode.h>
+#include <SDL2/SDL_surface.h>
+
+#include <sdlw/blend_mode.hpp>
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/surface.hpp>
+
+#include "sdlw/detail/simd.hpp"
+
+namespace sdl {
+
+// clang-format off
+
+// Porter-Duff over, saturating add, and multiply onto what lies beneath.
+// All three work on premultiplied colors.
+enum class composite_op {
+    over,
+    add,
+    multiply
+};
+
+// clang-format on
+
+// The renderer blend mode that combines premultiplied textures the way the
+// compositor combines premultiplied surfaces, for drawing the same layers
+// on the GPU.
+inline auto premultiplied_blend_mode(composite_op op) noexcept -> blend_mode
+{
+    auto mode = SDL_BLENDMODE_INVALID;
+    switch (op) {
+    case composite_op::over:
+        mode = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        break;
+    case composite_op::add:
+        mode = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD);
+        break;
+    case composite_op::multiply:
+        mode = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_DST_COLOR, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_DST_ALPHA, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        break;
+    }
+    return static_cast<blend_mode>(mode);
+}
+
+namespace detail {
+
+// x * y / 255, rounded, for x * y <= 255 * 255.
+constexpr auto mul_div255(u32 x, u32 y) noexcept -> u32
+{
+    const auto t = x * y + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+// Scales every channel of a pixel, alpha included, by f / 255.
+constexpr auto scale_pixel(u32 p, u32 f) noexcept -> u32
+{
+    auto out = u32{0};
+    for (auto shift = 0; shift < 32; shift += 8) {
+        out |= mul_div255((p >> shift) & 0xFF, f) << shift;
+    }
+    return out;
+}
+
+// Every kernel applies the same formula to all four channels:
+//   over:      s + d * (1 - sa)
+//   add:       min(s + d, 1)
+//   multiply:  s * d + d * (1 - sa)
+// which is what premultiplied_blend_mode() asks of the GPU.
+constexpr auto composite_pixel(composite_op op, u32 s, u32 d) noexcept -> u32
+{
+    const auto inv = 255 - (s >> 24);
+    auto out = u32{0};
+    for (auto shift = 0; shift < 32; shift += 8) {
+        const auto sc = (s >> shift) & 0xFF;
+        const auto dc = (d >> shift) & 0xFF;
+        auto c = u32{0};
+        switch (op) {
+        case composite_op::over: c = std::min(sc + mul_div255(dc, inv), u32{255}); break;
+        case composite_op::add: c = std::min(sc + dc, u32{255}); break;
+        case composite_op::multiply: c = mul_div255(dc, std::min(sc + inv, u32{255})); break;
+        }
+        out |= c << shift;
+    }
+    return out;
+}
+
+inline void composite_row_scalar(composite_op op, const u32* src, u32* dst, int count, u8 opacity) noexcept
+{
+    for (auto i = 0; i < count; ++i) {
+        const auto s = opacity == 255 ? src[i] : scale_pixel(src[i], opacity);
+        dst[i] = composite_pixel(op, s, dst[i]);
+    }
+}
+
+#if defined(SDLW_DETAIL_SIMD_X86)
+
+// The vector kernels below follow the scalar formulas byte for byte; the
+// only difference is that they work on 4 or 8 pixels at a time.
+
+SDLW_DETAIL_TARGET("sse2") inline auto mul_div255_sse2(__m128i x, __m128i y) noexcept -> __m128i
+{
+    const auto zero = _mm_setzero_si128();
+    const auto half = _mm_set1_epi16(128);
+    auto lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(x, zero), _mm_unpacklo_epi8(y, zero)), half);
+    auto hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(x, zero), _mm_unpackhi_epi8(y, zero)), half);
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+    return _mm_packus_epi16(lo, hi);
+}
+
+// Alpha copied into all four bytes of each pixel.
+SDLW_DETAIL_TARGET("sse2") inline auto broadcast_alpha_sse2(__m128i p) noexcept -> __m128i
+{
+    const auto a = _mm_srli_epi32(p, 24);
+    const auto aa = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+    return _mm_or_si128(aa, _mm_slli_epi32(aa, 16));
+}
+
+template<composite_op Op>
+SDLW_DETAIL_TARGET("sse2")
+inline auto composite_row_sse2(const u32* src, u32* dst, int count, u8 opacity) noexcept -> int
+{
+    const auto ones = _mm_set1_epi32(-1);
+    const auto scale = _mm_set1_epi8(static_cast<char>(opacity));
+    auto i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        if (opacity != 255) s = mul_div255_sse2(s, scale);
+        auto out = __m128i{};
+        if constexpr (Op == composite_op::over) {
+            const auto inv = _mm_xor_si128(broadcast_alpha_sse2(s), ones);
+            out = _mm_adds_epu8(s, mul_div255_sse2(d, inv));
+        } else if constexpr (Op == composite_op::add) {
+            out = _mm_adds_epu8(s, d);
+        } else {
+            const auto inv = _mm_xor_si128(broadcast_alpha_sse2(s), ones);
+            out = mul_div255_sse2(d, _mm_adds_epu8(s, inv));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+    }
+    return i;
+}
+
+SDLW_DETAIL_TARGET("avx2") inline auto mul_div255_avx2(__m256i x, __m256i y) noexcept -> __m256i
+{
+    // Unpacking and packing both stay within 128-bit lanes, so the bytes
+    // come back in order.
+    const auto zero = _mm256_setzero_si256();
+    const auto half = _mm256_set1_epi16(128);
+    auto lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(x, zero), _mm256_unpacklo_epi8(y, zero)), half);
+    auto hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(x, zero), _mm256_unpackhi_epi8(y, zero)), half);
+    lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+    hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+    return _mm256_packus_epi16(lo, hi);
+}
+
+SDLW_DETAIL_TARGET("avx2") inline auto broadcast_alpha_avx2(__m256i p) noexcept -> __m256i
+{
+    const auto a = _mm256_srli_epi32(p, 24);
+    const auto aa = _mm256_or_si256(a, _mm256_slli_epi32(a, 8));
+    return _mm256_or_si256(aa, _mm256_slli_epi32(aa, 16));
+}
+
+template<composite_op Op>
+SDLW_DETAIL_TARGET("avx2")
+inline auto composite_row_avx2(const u32* src, u32* dst, int count, u8 opacity) noexcept -> int
+{
+    const auto ones = _mm256_set1_epi32(-1);
+    const auto scale = _mm256_set1_epi8(static_cast<char>(opacity));
+    auto i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        if (opacity != 255) s = mul_div255_avx2(s, scale);
+        auto out = __m256i{};
+        if constexpr (Op == composite_op::over) {
+            const auto inv = _mm256_xor_si256(broadcast_alpha_avx2(s), ones);
+            out = _mm256_adds_epu8(s, mul_div255_avx2(d, inv));
+        } else if constexpr (Op == composite_op::add) {
+            out = _mm256_adds_epu8(s, d);
+        } else {
+            const auto inv = _mm256_xor_si256(broadcast_alpha_avx2(s), ones);
+            out = mul_div255_avx2(d, _mm256_adds_epu8(s, inv));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+    }
+    return i;
+}
+
+template<composite_op Op>
+inline auto composite_row_simd(const u32* src, u32* dst, int count, u8 opacity) noexcept -> int
+{
+    const auto level = simd_support();
+    auto done = 0;
+    if (level == simd_level::avx2) done = composite_row_avx2<Op>(src, dst, count, opacity);
+    if (level >= simd_level::sse2) done += composite_row_sse2<Op>(src + done, dst + done, count - done, opacity);
+    return done;
+}
+
+#endif
+
+inline void composite_row(composite_op op, const u32* src, u32* dst, int count, u8 opacity) noexcept
+{
+    auto done = 0;
+#if defined(SDLW_DETAIL_SIMD_X86)
+    switch (op) {
+    case composite_op::over: done = composite_row_simd<composite_op::over>(src, dst, count, opacity); break;
+    case composite_op::add: done = composite_row_simd<composite_op::add>(src, dst, count, opacity); break;
+    case composite_op::multiply: done = composite_row_simd<composite_op::multiply>(src, dst, count, opacity); break;
+    }
+#endif
+    composite_row_scalar(op, src + done, dst + done, count - done, opacity);
+}
+
+inline auto row_pixels(SDL_Surface* s, int x, int y) noexcept -> u32*
+{
+    return reinterpret_cast<u32*>(static_cast<u8*>(s->pixels) + static_cast<std::ptrdiff_t>(y) * s->pitch) + x;
+}
+
+} // namespace detail
+
+// A surface converted once to ARGB8888 with its colors multiplied by
+// alpha, ready to be composited any number of times. Color keys become
+// transparent pixels during the conversion.
+class premultiplied_surface {
+public:
+    explicit premultiplied_surface(const surface& s)
+        : _surface{to_argb8888(s)}
+    {
+        const auto p = _surface.get_pointer();
+        for (auto y = 0; y < p->h; ++y) {
+            const auto row = detail::row_pixels(p, 0, y);
+            for (auto x = 0; x < p->w; ++x) {
+                const auto a = row[x] >> 24;
+                if (a != 255) row[x] = detail::scale_pixel(row[x] & 0x00FFFFFF, a) | a << 24;
+            }
+        }
+    }
+
+    // Transparent black.
+    premultiplied_surface(int width, int height)
+        : _surface{width, height, 32, pixel_format_type::argb8888}
+    {
+        SDL_FillRect(_surface.get_pointer(), nullptr, 0);
+    }
+
+    // Premultiplied ARGB8888 pixels, e.g. for a texture drawn with
+    // premultiplied_blend_mode().
+    auto get() const noexcept -> const surface&
+    {
+        return _surface;
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _surface.size();
+    }
+
+    // Straight-alpha ARGB8888 copy, for saving or for blits with
+    // blend_mode::blend.
+    auto unpremultiplied() const -> surface
+    {
+        const auto p = _surface.get_pointer();
+        auto out = surface{p->w, p->h, 32, pixel_format_type::argb8888};
+        for (auto y = 0; y < p->h; ++y) {
+            const auto from = detail::row_pixels(p, 0, y);
+            const auto to = detail::row_pixels(out.get_pointer(), 0, y);
+            for (auto x = 0; x < p->w; ++x) {
+                const auto a = from[x] >> 24;
+                auto px = from[x];
+                if (a != 255) {
+                    px = a << 24;
+                    for (auto shift = 0; a != 0 && shift < 24; shift += 8) {
+                        px |= std::min((((from[x] >> shift) & 0xFF) * 255 + a / 2) / a, u32{255}) << shift;
+                    }
+                }
+                to[x] = px;
+            }
+        }
+        return out;
+    }
+
+private:
+    surface _surface;
+};
+
+// Software layer compositor. Layers are premultiplied_surfaces blended
+// onto a premultiplied ARGB8888 canvas with SSE2 or AVX2 kernels where the
+// CPU has them. The same layers uploaded as textures and drawn with
+// premultiplied_blend_mode() give the same picture on the GPU, up to the
+// GPU's rounding.
+class compositor {
+public:
+    // Transparent canvas.
+    compositor(int width, int height)
+        : _canvas{width, height}
+    {}
+
+    // Canvas starting from a copy of background.
+    explicit compositor(const surface& background)
+        : _canvas{background}
+    {}
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _canvas.size();
+    }
+
+    auto canvas() const noexcept -> const premultiplied_surface&
+    {
+        return _canvas;
+    }
+
+    // Fills the canvas with a straight-alpha color.
+    void clear(const color& c = {0, 0, 0, 0}) noexcept
+    {
+        const auto straight = u32{c.r} << 16 | u32{c.g} << 8 | u32{c.b};
+        const auto px = detail::scale_pixel(straight, c.a) | u32{c.a} << 24;
+        SDL_FillRect(_canvas.get().get_pointer(), nullptr, px);
+    }
+
+    // Blends layer with its top left corner at at, scaled by opacity.
+    void draw(const premultiplied_surface& layer, const point& at, composite_op op = composite_op::over, u8 opacity = 255) noexcept
+    {
+        const auto s = _canvas.get().get_pointer();
+        draw(layer, at, rect{0, 0, s->w, s->h}, op, opacity);
+    }
+
+    // Same as above, touching only canvas pixels inside clip.
+    void draw(const premultiplied_surface& layer, const point& at, const rect& clip, composite_op op = composite_op::over, u8 opacity = 255) noexcept
+    {
+        if (opacity == 0) return;
+        const auto canvas = _canvas.get().get_pointer();
+        const auto src = layer.get().get_pointer();
+        const auto bounds = intersection(clip, rect{0, 0, canvas->w, canvas->h});
+        if (!bounds) return;
+        const auto area = intersection(*bounds, rect{at.x, at.y, src->w, src->h});
+        if (!area) return;
+        for (auto y = area->y; y < area->y + area->h; ++y) {
+            const auto from = detail::row_pixels(src, area->x - at.x, y - at.y);
+            detail::composite_row(op, from, detail::row_pixels(canvas, area->x, y), area->w, opacity);
+        }
+    }
+
+private:
+    premultiplied_surface _canvas;
+};
+
+} // namespace sdl
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <sdlw/rect.hpp>
+#include <sdlw/video.hpp>
+
+namespace sdl {
+
+// Accumulates the areas of a window surface that changed during a frame and
+// pushes only those to the screen. The damage is clipped to the window,
+// reduced to at most max_rects rectangles, and cleared by present().
+class damage_tracker {
+public:
+    explicit damage_tracker(window& w, std::size_t max_rects = 16) noexcept
+        : _window{w}
+        , _max_rects{max_rects}
+    {}
+
+    damage_tracker(const damage_tracker&) = delete;
+    auto operator=(const damage_tracker&) -> damage_tracker& = delete;
+
+    void damage(const rect& r)
+    {
+        if (!_full) _damage.unite(r);
+    }
+
+    void damage(const region& r)
+    {
+        if (!_full) _damage.unite(r);
+    }
+
+    // Marks the whole surface, e.g. after a resize or an expose event.
+    void damage_all() noexcept
+    {
+        _full = true;
+        _damage.clear();
+    }
+
+    auto damaged() const noexcept -> const region&
+    {
+        return _damage;
+    }
+
+    // Pixels pushed by the last present().
+    auto presented_area() const noexcept -> long long
+    {
+        return _presented_area;
+    }
+
+    void present()
+    {
+        const auto sz = _window.size();
+        const auto bounds = rect{0, 0, sz.w, sz.h};
+        _damage.intersect(bounds);
+        _damage.simplify(_max_rects);
+        if (_full || _damage.area() == detail::area_of(bounds)) {
+            _window.update_surface();
+            _presented_area = detail::area_of(bounds);
+        } else if (!_damage.empty()) {
+            _window.update_surface_areas(_damage.rects());
+            _presented_area = _damage.area();
+        } else {
+            _presented_area = 0;
+        }
+        _damage.clear();
+        _full = false;
+    }
+
+private:
+    window& _window;
+    std::size_t _max_rects;
+    region _damage;
+    long long _presented_area = 0;
+    bool _full = false;
+};
+
+} // namespace sdl
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <cstring>
+#include <optional>
+
+#include <SDL2/SDL_pixels.h>
+
+#include <sdlw/pixels.hpp>
+#include <sdlw/types.hpp>
+
+#include "sdlw/detail/simd.hpp"
+
+// Vectorized row kernels behind convert_pixels for the 8888, 24-bit and 565
+// formats. Every pixel is moved with a byte shuffle: 24 and 32-bit pixels
+// directly, 565 pixels after being widened to, or before being narrowed
+// from, four bytes. The results match SDL_ConvertPixels bit for bit; other
+// pairs, and CPUs without SSSE3, are left to SDL.
+
+namespace sdl::detail {
+
+// clang-format off
+
+enum class pixel_kind {
+    bytes4,
+    bytes3,
+    packed565
+};
+
+// clang-format on
+
+// Byte offsets of each channel in a pixel as laid out in memory; a is
+// negative when there is no alpha. 565 pixels are described by the four
+// bytes they widen to: the high field first, then green, the low field and
+// an opaque alpha.
+struct channel_layout {
+    pixel_kind kind;
+    int r, g, b, a;
+};
+
+// The formats with kernels. x86 is little-endian, so ARGB8888 is stored as
+// B, G, R, A.
+inline auto channel_layout_of(pixel_format_type format) noexcept -> std::optional<channel_layout>
+{
+    switch (format) {
+    case pixel_format_type::argb8888: return channel_layout{pixel_kind::bytes4, 2, 1, 0, 3};
+    case pixel_format_type::rgba8888: return channel_layout{pixel_kind::bytes4, 3, 2, 1, 0};
+    case pixel_format_type::abgr8888: return channel_layout{pixel_kind::bytes4, 0, 1, 2, 3};
+    case pixel_format_type::bgra8888: return channel_layout{pixel_kind::bytes4, 1, 2, 3, 0};
+    case pixel_format_type::rgb24: return channel_layout{pixel_kind::bytes3, 0, 1, 2, -1};
+    case pixel_format_type::bgr24: return channel_layout{pixel_kind::bytes3, 2, 1, 0, -1};
+    case pixel_format_type::rgb565: return channel_layout{pixel_kind::packed565, 0, 1, 2, 3};
+    case pixel_format_type::bgr565: return channel_layout{pixel_kind::packed565, 2, 1, 0, 3};
+    default: return std::nullopt;
+    }
+}
+
+constexpr auto shuffle_size(pixel_kind kind) noexcept -> int
+{
+    return kind == pixel_kind::bytes3 ? 3 : 4;
+}
+
+constexpr auto pixel_size(pixel_kind kind) noexcept -> int
+{
+    return kind == pixel_kind::packed565 ? 2 : shuffle_size(kind);
+}
+
+// Shuffle for four pixels, in _mm_shuffle_epi8 form: output byte i is input
+// byte shuffle[i], or zero when its high bit is set, then OR'ed with fill.
+// fill makes the alpha opaque when the source has none.
+struct convert_plan {
+    channel_layout src;
+    channel_layout dst;
+    alignas(16) u8 shuffle[16];
+    alignas(16) u8 fill[16];
+};
+
+inline auto make_convert_plan(const channel_layout& src, const channel_layout& dst) noexcept -> convert_plan
+{
+    auto plan = convert_plan{src, dst, {}, {}};
+    std::memset(plan.shuffle, 0x80, sizeof(plan.shuffle));
+    const int from[] = {src.r, src.g, src.b, src.a};
+    const int to[] = {dst.r, dst.g, dst.b, dst.a};
+    const auto src_size = shuffle_size(src.kind);
+    const auto dst_size = shuffle_size(dst.kind);
+    for (auto p = 0; p < 4; ++p) {
+        for (auto c = 0; c < 4; ++c) {
+            if (to[c] < 0) continue;
+            const auto i = p * dst_size + to[c];
+            if (from[c] < 0) {
+                plan.fill[i] = 0xff;
+            } else {
+                plan.shuffle[i] = static_cast<u8>(p * src_size + from[c]);
+            }
+        }
+    }
+    return plan;
+}
+
+// SDL widens 5 and 6-bit channels to floor(v * 255 / max); the kernels
+// compute the same with a multiply-high. Checked once against the SDL in
+// use so a different rounding sends 565 sources back to SDL.
+constexpr auto widen5(unsigned v) noexcept -> u8
+{
+    return static_cast<u8>(v * 255 / 31);
+}
+
+constexpr auto widen6(unsigned v) noexcept -> u8
+{
+    return static_cast<u8>(v * 255 / 63);
+}
+
+inline auto sdl_widens_565_like_kernels() noexcept -> bool
+{
+    static const auto same = [] {
+        const auto format = SDL_AllocFormat(SDL_PIXELFORMAT_RGB565);
+        if (!format) return false;
+        auto ok = true;
+        for (auto v = 0u; v < 64 && ok; ++v) {
+            auto r = u8{};
+            auto g = u8{};
+            auto b = u8{};
+            SDL_GetRGB((v & 31) << 11 | v << 5 | (v & 31), format, &r, &g, &b);
+            ok = r == widen5(v & 31) && g == widen6(v) && b == widen5(v & 31);
+        }
+        SDL_FreeFormat(format);
+        return ok;
+    }();
+    return same;
+}
+
+// Converts count pixels one at a time with the same shuffle as the vector
+// kernels; used for the ends of rows.
+inline void convert_row_scalar(const u8* src, u8* dst, int count, const convert_plan& plan) noexcept
+{
+    const auto src_size = pixel_size(plan.src.kind);
+    const auto dst_size = pixel_size(plan.dst.kind);
+    for (auto x = 0; x < count; ++x, src += src_size, dst += dst_size) {
+        u8 in[4];
+        if (plan.src.kind == pixel_kind::packed565) {
+            auto p = u16{};
+            std::memcpy(&p, src, 2);
+            in[0] = widen5(p >> 11u);
+            in[1] = widen6((p >> 5u) & 63u);
+            in[2] = widen5(p & 31u);
+            in[3] = 0xff;
+        } else {
+            std::memcpy(in, src, static_cast<std::size_t>(src_size));
+        }
+
+        u8 out[4];
+        for (auto i = 0; i < shuffle_size(plan.dst.kind); ++i) {
+            const auto s = plan.shuffle[i];
+            out[i] = static_cast<u8>(((s & 0x80) ? 0 : in[s]) | plan.fill[i]);
+        }
+
+        if (plan.dst.kind == pixel_kind::packed565) {
+            const auto p = static_cast<u16>((out[0] & 0xf8u) << 8u | (out[1] & 0xfcu) << 3u | out[2] >> 3u);
+            std::memcpy(dst, &p, 2);
+        } else {
+            std::memcpy(dst, out, static_cast<std::size_t>(dst_size));
+        }
+    }
+}
+
+#if defined(SDLW_DETAIL_SIMD_X86)
+
+// Eight 565 pixels to two registers of four RGBA pixels.
+SDLW_DETAIL_TARGET("ssse3") inline void widen565_ssse3(__m128i p, __m128i& lo, __m128i& hi) noexcept
+{
+    const auto hi5 = _mm_srli_epi16(p, 11);
+    const auto mid6 = _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(63));
+    const auto lo5 = _mm_and_si128(p, _mm_set1_epi16(31));
+    const auto c255 = _mm_set1_epi16(255);
+    const auto r = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(hi5, c255), _mm_set1_epi16(8457)), 2);
+    const auto g = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(mid6, c255), _mm_set1_epi16(16645)), 4);
+    const auto b = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(lo5, c255), _mm_set1_epi16(8457)), 2);
+    const auto rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    const auto ba = _mm_or_si128(b, _mm_set1_epi16(static_cast<short>(0xff00)));
+    lo = _mm_unpacklo_epi16(rg, ba);
+    hi = _mm_unpackhi_epi16(rg, ba);
+}
+
+// Four RGBA pixels to 565 in the low half of each 32-bit lane, sign
+// extended so _mm_packs_epi32 keeps the bits.
+SDLW_DETAIL_TARGET("ssse3") inline auto narrow565_ssse3(__m128i v) noexcept -> __m128i
+{
+    const auto r = _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xf8)), 8);
+    const auto g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x7e0));
+    const auto b = _mm_and_si128(_mm_srli_epi32(v, 19), _mm_set1_epi32(0x1f));
+    const auto p = _mm_or_si128(_mm_or_si128(r, g), b);
+    return _mm_srai_epi32(_mm_slli_epi32(p, 16), 16);
+}
+
+// Returns the number of pixels converted; the caller finishes the row.
+// 24-bit pixels are moved with 16-byte loads and stores, which reach up to
+// two pixels past the eight handled, so the loop stops early enough for
+// the row to hold them; the extra bytes written are rewritten afterwards.
+template<pixel_kind Src, pixel_kind Dst>
+SDLW_DETAIL_TARGET("ssse3")
+inline auto convert_row_ssse3(const u8* src, u8* dst, int width, const convert_plan& plan) noexcept -> int
+{
+    constexpr auto src_size = pixel_size(Src);
+    constexpr auto dst_size = pixel_size(Dst);
+    constexpr auto reach = Src == pixel_kind::bytes3 || Dst == pixel_kind::bytes3 ? 10 : 8;
+    const auto shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(plan.shuffle));
+    const auto fill = _mm_load_si128(reinterpret_cast<const __m128i*>(plan.fill));
+
+    auto x = 0;
+    for (; x + reach <= width; x += 8) {
+        const auto s = src + x * src_size;
+        auto lo = __m128i{};
+        auto hi = __m128i{};
+        if constexpr (Src == pixel_kind::packed565) {
+            widen565_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)), lo, hi);
+        } else {
+            lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * src_size));
+        }
+        lo = _mm_or_si128(_mm_shuffle_epi8(lo, shuffle), fill);
+        hi = _mm_or_si128(_mm_shuffle_epi8(hi, shuffle), fill);
+
+        const auto d = dst + x * dst_size;
+        if constexpr (Dst == pixel_kind::packed565) {
+            const auto p = _mm_packs_epi32(narrow565_ssse3(lo), narrow565_ssse3(hi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d), p);
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d), lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4 * dst_size), hi);
+        }
+    }
+    return x;
+}
+
+SDLW_DETAIL_TARGET("avx2") inline auto load_2x128(const u8* lo, const u8* hi) noexcept -> __m256i
+{
+    const auto l = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lo)));
+    return _mm256_inserti128_si256(l, _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi)), 1);
+}
+
+SDLW_DETAIL_TARGET("avx2") inline void store_2x128(u8* lo, u8* hi, __m256i v) noexcept
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lo), _mm256_castsi256_si128(v));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(hi), _mm256_extracti128_si256(v, 1));
+}
+
+SDLW_DETAIL_TARGET("avx2") inline void widen565_avx2(__m256i p, __m256i& lo, __m256i& hi) noexcept
+{
+    const auto hi5 = _mm256_srli_epi16(p, 11);
+    const auto mid6 = _mm256_and_si256(_mm256_srli_epi16(p, 5), _mm256_set1_epi16(63));
+    const auto lo5 = _mm256_and_si256(p, _mm256_set1_epi16(31));
+    const auto c255 = _mm256_set1_epi16(255);
+    const auto r = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(hi5, c255), _mm256_set1_epi16(8457)), 2);
+    const auto g = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(mid6, c255), _mm256_set1_epi16(16645)), 4);
+    const auto b = _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(lo5, c255), _mm256_set1_epi16(8457)), 2);
+    const auto rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+    const auto ba = _mm256_or_si256(b, _mm256_set1_epi16(static_cast<short>(0xff00)));
+    // Unpacking works within 128-bit lanes: pixels 0-3 and 8-11 land in lo.
+    const auto l = _mm256_unpacklo_epi16(rg, ba);
+    const auto h = _mm256_unpackhi_epi16(rg, ba);
+    lo = _mm256_permute2x128_si256(l, h, 0x20);
+    hi = _mm256_permute2x128_si256(l, h, 0x31);
+}
+
+SDLW_DETAIL_TARGET("avx2") inline auto narrow565_avx2(__m256i v) noexcept -> __m256i
+{
+    const auto r = _mm256_slli_epi32(_mm256_and_si256(v, _mm256_set1_epi32(0xf8)), 8);
+    const auto g = _mm256_and_si256(_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x7e0));
+    const auto b = _mm256_and_si256(_mm256_srli_epi32(v, 19), _mm256_set1_epi32(0x1f));
+    const auto p = _mm256_or_si256(_mm256_or_si256(r, g), b);
+    return _mm256_srai_epi32(_mm256_slli_epi32(p, 16), 16);
+}
+
+// Sixteen pixels per step, four per 128-bit lane.
+template<pixel_kind Src, pixel_kind Dst>
+SDLW_DETAIL_TARGET("avx2")
+inline auto convert_row_avx2(const u8* src, u8* dst, int width, const convert_plan& plan) noexcept -> int
+{
+    constexpr auto src_size = pixel_size(Src);
+    constexpr auto dst_size = pixel_size(Dst);
+    constexpr auto reach = Src == pixel_kind::bytes3 || Dst == pixel_kind::bytes3 ? 18 : 16;
+    const auto shuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(plan.shuffle)));
+    const auto fill = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(plan.fill)));
+
+    auto x = 0;
+    for (; x + reach <= width; x += 16) {
+        const auto s = src + x * src_size;
+        auto lo = __m256i{};
+        auto hi = __m256i{};
+        if constexpr (Src == pixel_kind::packed565) {
+            widen565_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)), lo, hi);
+        } else if constexpr (Src == pixel_kind::bytes3) {
+            lo = load_2x128(s, s + 12);
+            hi = load_2x128(s + 24, s + 36);
+        } else {
+            lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+            hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+        }
+        lo = _mm256_or_si256(_mm256_shuffle_epi8(lo, shuffle), fill);
+        hi = _mm256_or_si256(_mm256_shuffle_epi8(hi, shuffle), fill);
+
+        const auto d = dst + x * dst_size;
+        if constexpr (Dst == pixel_kind::packed565) {
+            const auto p = _mm256_packs_epi32(narrow565_avx2(lo), narrow565_avx2(hi));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_permute4x64_epi64(p, 0xd8));
+        } else if constexpr (Dst == pixel_kind::bytes3) {
+            store_2x128(d, d + 12, lo);
+            store_2x128(d + 24, d + 36, hi);
+        } else {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), lo);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32), hi);
+        }
+    }
+    return x;
+}
+
+using convert_row_fn = int (*)(const u8*, u8*, int, const convert_plan&) noexcept;
+
+template<pixel_kind Src, pixel_kind Dst>
+auto convert_row_kernel(simd_level level) noexcept -> convert_row_fn
+{
+    return level == simd_level::avx2 ? convert_row_avx2<Src, Dst> : convert_row_ssse3<Src, Dst>;
+}
+
+template<pixel_kind Src>
+auto convert_row_kernel(pixel_kind dst, simd_level level) noexcept -> convert_row_fn
+{
+    switch (dst) {
+    case pixel_kind::bytes4: return convert_row_kernel<Src, pixel_kind::bytes4>(level);
+    case pixel_kind::bytes3: return convert_row_kernel<Src, pixel_kind::bytes3>(level);
+    case pixel_kind::packed565: return convert_row_kernel<Src, pixel_kind::packed565>(level);
+    }
+    return nullptr;
+}
+
+#endif
+
+// Converts with a vector kernel when there is one for the pair and the CPU,
+// and returns false without touching dst otherwise.
+inline auto convert_pixels_simd(
+    int width,
+    int height,
+    pixel_format_type src_format,
+    const void* src,
+    int src_pitch,
+    pixel_format_type dst_format,
+    void* dst,
+    int dst_pitch) noexcept -> bool
+{
+#if defined(SDLW_DETAIL_SIMD_X86)
+    const auto level = simd_support();
+    if (level < simd_level::ssse3) return false;
+    if (src_format == dst_format || width <= 0 || height <= 0 || !src || !dst) return false;
+    const auto from = channel_layout_of(src_format);
+    const auto to = channel_layout_of(dst_format);
+    if (!from || !to) return false;
+    if (from->kind == pixel_kind::packed565 && !sdl_widens_565_like_kernels()) return false;
+
+    const auto plan = make_convert_plan(*from, *to);
+    auto kernel = convert_row_fn{};
+    switch (from->kind) {
+    case pixel_kind::bytes4: kernel = convert_row_kernel<pixel_kind::bytes4>(to->kind, level); break;
+    case pixel_kind::bytes3: kernel = convert_row_kernel<pixel_kind::bytes3>(to->kind, level); break;
+    case pixel_kind::packed565: kernel = convert_row_kernel<pixel_kind::packed565>(to->kind, level); break;
+    }
+
+    const auto src_size = pixel_size(from->kind);
+    const auto dst_size = pixel_size(to->kind);
+    for (auto y = 0; y < height; ++y) {
+        const auto s = static_cast<const u8*>(src) + static_cast<std::ptrdiff_t>(y) * src_pitch;
+        const auto d = static_cast<u8*>(dst) + static_cast<std::ptrdiff_t>(y) * dst_pitch;
+        const auto done = kernel(s, d, width, plan);
+        convert_row_scalar(s + done * src_size, d + done * dst_size, width - done, plan);
+    }
+    return true;
+#else
+    static_cast<void>(width);
+    static_cast<void>(height);
+    static_cast<void>(src_format);
+    static_cast<void>(src);
+    static_cast<void>(src_pitch);
+    static_cast<void>(dst_format);
+    static_cast<void>(dst);
+    static_cast<void>(dst_pitch);
+    return false;
+#endif
+}
+
+} // namespace sdl::detail
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <sdlw/cpu_info.hpp>
+#include <sdlw/types.hpp>
+
+// Instruction sets the SIMD kernels may use. x86 kernels are compiled with
+// per-function target attributes and picked at run time, so the library
+// needs no -mavx2; NEON is part of the ARMv8 baseline and chosen at compile
+// time. Define SDLW_NO_SIMD to force the scalar kernels everywhere.
+#if !defined(SDLW_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SDLW_DETAIL_SIMD_X86 1
+#include <immintrin.h>
+#elif !defined(SDLW_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define SDLW_DETAIL_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SDLW_DETAIL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SDLW_DETAIL_TARGET(isa)
+#endif
+
+namespace sdl::detail {
+
+// clang-format off
+
+enum class simd_level {
+    scalar,
+    sse2,
+    ssse3,
+    avx2,
+    neon
+};
+
+// clang-format on
+
+// Best level supported by both the build and the running CPU, detected
+// once. Each level implies the ones before it.
+inline auto simd_support() noexcept -> simd_level
+{
+    static const auto level = [] {
+#if defined(SDLW_DETAIL_SIMD_X86)
+        if (cpu_info::has_avx2()) return simd_level::avx2;
+        // SDL2 cannot report SSSE3 on its own; every SSE4.1 CPU has it.
+        if (cpu_info::has_sse41()) return simd_level::ssse3;
+        if (cpu_info::has_sse2()) return simd_level::sse2;
+#elif defined(SDLW_DETAIL_SIMD_NEON)
+        return simd_level::neon;
+#endif
+        return simd_level::scalar;
+    }();
+    return level;
+}
+
+// Writes one 0/1 byte per lane of a compare bitmask.
+inline void store_mask_bytes(unsigned bits, u8* out, int count) noexcept
+{
+    for (auto i = 0; i < count; ++i) {
+        out[i] = static_cast<u8>((bits >> i) & 1u);
+    }
+}
+
+inline auto popcount(unsigned bits) noexcept -> int
+{
+    auto count = 0;
+    for (; bits != 0; bits &= bits - 1) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace sdl::detail
@@ -1,8 +1,24 @@
 #pragma once
 
+#include <cstdlib>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 #include <SDL2/SDL_error.h>
+#include <SDL2/SDL_log.h>
+
+#if !defined(SDLW_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#    define SDLW_NO_EXCEPTIONS
+#endif
+
+#if defined(SDLW_NO_EXCEPTIONS)
+#    define SDLW_DETAIL_THROW_ERROR() ::sdl::detail::fatal_error()
+#else
+#    define SDLW_DETAIL_THROW_ERROR() throw ::sdl::error{}
+#endif
 
 namespace sdl {
 
@@ -28,4 +44,196 @@ void set_error(const char* fmt, Args... args) noexcept
     SDL_SetError(fmt, args...);
 }
 
+namespace detail {
+
+// Stands in for `throw error{}` when exceptions are disabled.
+[[noreturn]] inline void fatal_error() noexcept
+{
+    SDL_LogCritical(SDL_LOG_CATEGORY_ERROR, "%s", SDL_GetError());
+    std::abort();
+}
+
+} // namespace detail
+
+// Failure of an SDL call, as returned by the std::nothrow overloads. Holds
+// only the negative return code; the text stays in SDL's per-thread error
+// buffer until message() asks for it, and is overwritten by the next failing
+// SDL call on the same thread.
+class error_code {
+public:
+    constexpr error_code() noexcept = default;
+
+    constexpr explicit error_code(int value) noexcept
+        : _value{value}
+    {}
+
+    constexpr auto value() const noexcept -> int
+    {
+        return _value;
+    }
+
+    auto message() const noexcept -> const char*
+    {
+        return SDL_GetError();
+    }
+
+private:
+    int _value = -1;
+};
+
+template<typename E>
+class unexpected {
+public:
+    constexpr explicit unexpected(E e) noexcept(std::is_nothrow_move_constructible_v<E>)
+        : _error{std::move(e)}
+    {}
+
+    constexpr auto error() const noexcept -> const E&
+    {
+        return _error;
+    }
+
+private:
+    E _error;
+};
+
+// Minimal value-or-error result. value() on an error raises sdl::error (or
+// aborts with SDLW_NO_EXCEPTIONS); check has_value() first on hot paths.
+template<typename T, typename E = error_code>
+class [[nodiscard]] expected {
+public:
+    using value_type = T;
+    using error_type = E;
+
+    constexpr expected(const T& v)
+        : _storage{std::in_place_index<0>, v}
+    {}
+
+    constexpr expected(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _storage{std::in_place_index<0>, std::move(v)}
+    {}
+
+    constexpr expected(unexpected<E> u) noexcept
+        : _storage{std::in_place_index<1>, u.error()}
+    {}
+
+    constexpr auto has_value() const noexcept -> bool
+    {
+        return _storage.index() == 0;
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    constexpr auto operator*() & noexcept -> T&
+    {
+        return *std::get_if<0>(&_storage);
+    }
+
+    constexpr auto operator*() const& noexcept -> const T&
+    {
+        return *std::get_if<0>(&_storage);
+    }
+
+    constexpr auto operator*() && noexcept -> T&&
+    {
+        return std::move(*std::get_if<0>(&_storage));
+    }
+
+    constexpr auto operator->() noexcept -> T*
+    {
+        return std::get_if<0>(&_storage);
+    }
+
+    constexpr auto operator->() const noexcept -> const T*
+    {
+        return std::get_if<0>(&_storage);
+    }
+
+    auto value() & -> T&
+    {
+        if (!has_value()) SDLW_DETAIL_THROW_ERROR();
+        return **this;
+    }
+
+    auto value() const& -> const T&
+    {
+        if (!has_value()) SDLW_DETAIL_THROW_ERROR();
+        return **this;
+    }
+
+    auto value() && -> T&&
+    {
+        if (!has_value()) SDLW_DETAIL_THROW_ERROR();
+        return std::move(**this);
+    }
+
+    template<typename U>
+    constexpr auto value_or(U&& fallback) const& -> T
+    {
+        return has_value() ? **this : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    constexpr auto error() const noexcept -> const E&
+    {
+        return *std::get_if<1>(&_storage);
+    }
+
+private:
+    std::variant<T, E> _storage;
+};
+
+template<typename E>
+class [[nodiscard]] expected<void, E> {
+public:
+    using value_type = void;
+    using error_type = E;
+
+    constexpr expected() noexcept = default;
+
+    constexpr expected(unexpected<E> u) noexcept
+        : _error{u.error()}
+        , _has_value{false}
+    {}
+
+    constexpr auto has_value() const noexcept -> bool
+    {
+        return _has_value;
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return _has_value;
+    }
+
+    void value() const
+    {
+        if (!_has_value) SDLW_DETAIL_THROW_ERROR();
+    }
+
+    constexpr auto error() const noexcept -> const E&
+    {
+        return _error;
+    }
+
+private:
+    E _error = {};
+    bool _has_value = true;
+};
+
+// Outcome of an SDL call that yields nothing: converts to true on success.
+using status = expected<void>;
+
+namespace detail {
+
+// Maps SDL's "negative on failure" convention onto status.
+constexpr auto make_status(int result) noexcept -> status
+{
+    return result < 0 ? status{unexpected{error_code{result}}} : status{};
+}
+
+} // namespace detail
+
 } // namespace sdl
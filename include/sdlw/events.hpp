@@ -1,5 +1,6 @@
 #pragma once
 
+#include <new>
 #include <optional>
 
 #include <SDL2/SDL_events.h>
@@ -678,7 +679,17 @@ inline auto push(const event& e) -> bool
 {
     const auto result = SDL_PushEvent(reinterpret_cast<SDL_Event*>(const_cast<event*>(&e)));
     if (result < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
+    } else {
+        return static_cast<bool>(result);
+    }
+}
+
+inline auto push(const event& e, std::nothrow_t) noexcept -> expected<bool>
+{
+    const auto result = SDL_PushEvent(reinterpret_cast<SDL_Event*>(const_cast<event*>(&e)));
+    if (result < 0) {
+        return unexpected{error_code{result}};
     } else {
         return static_cast<bool>(result);
     }
@@ -698,7 +709,20 @@ inline auto add(span<const event> events, event_type min, event_type max) -> int
     const auto amax = static_cast<u32>(max);
     const auto res = SDL_PeepEvents(p_events, size, SDL_ADDEVENT, amin, amax);
     if (res < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
+    } else {
+        return res;
+    }
+}
+
+inline auto add(span<const event> events, event_type min, event_type max, std::nothrow_t) noexcept -> expected<int>
+{
+    const auto cevents = const_cast<event*>(events.data());
+    const auto p_events = reinterpret_cast<SDL_Event*>(cevents);
+    const auto size = static_cast<int>(events.size());
+    const auto res = SDL_PeepEvents(p_events, size, SDL_ADDEVENT, static_cast<u32>(min), static_cast<u32>(max));
+    if (res < 0) {
+        return unexpected{error_code{res}};
     } else {
         return res;
     }
@@ -713,7 +737,20 @@ inline auto peek(span<event> events, event_type min, event_type max) -> int
     const auto amax = static_cast<u32>(max);
     const auto res = SDL_PeepEvents(p_events, size, SDL_PEEKEVENT, amin, amax);
     if (res < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
+    } else {
+        return res;
+    }
+}
+
+inline auto peek(span<event> events, event_type min, event_type max, std::nothrow_t) noexcept -> expected<int>
+{
+    const auto cevents = const_cast<event*>(events.data());
+    const auto p_events = reinterpret_cast<SDL_Event*>(cevents);
+    const auto size = static_cast<int>(events.size());
+    const auto res = SDL_PeepEvents(p_events, size, SDL_PEEKEVENT, static_cast<u32>(min), static_cast<u32>(max));
+    if (res < 0) {
+        return unexpected{error_code{res}};
     } else {
         return res;
     }
@@ -728,7 +765,20 @@ inline auto get(span<event> events, event_type min, event_type max) -> int
     const auto amax = static_cast<u32>(max);
     const auto res = SDL_PeepEvents(p_events, size, SDL_GETEVENT, amin, amax);
     if (res < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
+    } else {
+        return res;
+    }
+}
+
+inline auto get(span<event> events, event_type min, event_type max, std::nothrow_t) noexcept -> expected<int>
+{
+    const auto cevents = const_cast<event*>(events.data());
+    const auto p_events = reinterpret_cast<SDL_Event*>(cevents);
+    const auto size = static_cast<int>(events.size());
+    const auto res = SDL_PeepEvents(p_events, size, SDL_GETEVENT, static_cast<u32>(min), static_cast<u32>(max));
+    if (res < 0) {
+        return unexpected{error_code{res}};
     } else {
         return res;
     }
@@ -15,7 +15,7 @@ inline auto base_path() -> std::unique_ptr<const char[], detail::sdl_string_dele
     if (const auto path = SDL_GetBasePath()) {
         return std::unique_ptr<const char[], detail::sdl_string_deleter>(path);
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -24,7 +24,7 @@ inline auto get_pref_path(const char* org, const char* app) -> std::unique_ptr<c
     if (const auto path = SDL_GetPrefPath(org, app)) {
         return std::unique_ptr<const char[], detail::sdl_string_deleter>(path);
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
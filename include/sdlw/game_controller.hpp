@@ -117,7 +117,7 @@ public:
     explicit game_controller(int joystick_index)
         : _game_controller{SDL_GameControllerOpen(joystick_index)}
     {
-        if (!_game_controller) throw error{};
+        if (!_game_controller) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto attached() const noexcept -> bool
@@ -169,21 +169,21 @@ public:
     static auto add_mapping(const char* mapping_string) -> bool
     {
         const auto result = SDL_GameControllerAddMapping(mapping_string);
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return static_cast<bool>(result);
     }
 
     static auto add_mappings(const char* filename) -> int
     {
         const auto result = SDL_GameControllerAddMappingsFromFile(filename);
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
     static auto add_mappings(stream& s) -> int
     {
         const auto result = SDL_GameControllerAddMappingsFromRW(s.get_pointer(), 0);
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
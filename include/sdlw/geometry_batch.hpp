@@ -0,0 +1,484 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+
+#include <sdlw/assert.hpp>
+#include <sdlw/detail/simd.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/types.hpp>
+
+namespace sdl {
+
+namespace detail {
+
+// Every kernel below processes elements [first, n) and gives the same
+// results as the scalar version at every SIMD level. Rects and points are
+// read as packed ints: {x, y, w, h} and {x, y}.
+
+inline auto are_intersecting_scalar(const rect& q, const rect* rects, u8* out, std::size_t first, std::size_t n) noexcept
+    -> std::size_t
+{
+    auto count = std::size_t{0};
+    for (auto i = first; i < n; ++i) {
+        const auto& r = rects[i];
+        const auto hit = r.w > 0 && r.h > 0 && r.x < q.x + q.w && q.x < r.x + r.w && r.y < q.y + q.h && q.y < r.y + r.h;
+        out[i] = static_cast<u8>(hit);
+        count += hit;
+    }
+    return count;
+}
+
+inline auto is_point_in_rectangles_scalar(const point& p, const rect* rects, u8* out, std::size_t first, std::size_t n) noexcept
+    -> std::size_t
+{
+    auto count = std::size_t{0};
+    for (auto i = first; i < n; ++i) {
+        const auto& r = rects[i];
+        const auto hit = p.x >= r.x && p.y >= r.y && p.x < r.x + r.w && p.y < r.y + r.h;
+        out[i] = static_cast<u8>(hit);
+        count += hit;
+    }
+    return count;
+}
+
+inline void translate_points_scalar(const point* in, const point& offset, point* out, std::size_t first, std::size_t n) noexcept
+{
+    for (auto i = first; i < n; ++i) {
+        out[i] = point{in[i].x + offset.x, in[i].y + offset.y};
+    }
+}
+
+inline void scale_points_scalar(const point* in, float sx, float sy, point* out, std::size_t first, std::size_t n) noexcept
+{
+    for (auto i = first; i < n; ++i) {
+        out[i] = point{static_cast<int>(static_cast<float>(in[i].x) * sx), static_cast<int>(static_cast<float>(in[i].y) * sy)};
+    }
+}
+
+// min and max hold {x, y} and are updated in place.
+inline void bounds_scalar(const point* points, std::size_t first, std::size_t n, point& min, point& max) noexcept
+{
+    for (auto i = first; i < n; ++i) {
+        min.x = std::min(min.x, points[i].x);
+        min.y = std::min(min.y, points[i].y);
+        max.x = std::max(max.x, points[i].x);
+        max.y = std::max(max.y, points[i].y);
+    }
+}
+
+#if defined(SDLW_DETAIL_SIMD_X86)
+
+// Loads four rects and transposes them into x, y, w and h vectors.
+SDLW_DETAIL_TARGET("sse2")
+inline void load_rects_sse2(const rect* rects, __m128i& x, __m128i& y, __m128i& w, __m128i& h) noexcept
+{
+    const auto r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects + 0));
+    const auto r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects + 1));
+    const auto r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects + 2));
+    const auto r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects + 3));
+    const auto t0 = _mm_unpacklo_epi32(r0, r1);
+    const auto t1 = _mm_unpacklo_epi32(r2, r3);
+    const auto t2 = _mm_unpackhi_epi32(r0, r1);
+    const auto t3 = _mm_unpackhi_epi32(r2, r3);
+    x = _mm_unpacklo_epi64(t0, t1);
+    y = _mm_unpackhi_epi64(t0, t1);
+    w = _mm_unpacklo_epi64(t2, t3);
+    h = _mm_unpackhi_epi64(t2, t3);
+}
+
+SDLW_DETAIL_TARGET("sse2")
+inline auto are_intersecting_sse2(const rect& q, const rect* rects, u8* out, std::size_t n) noexcept -> std::size_t
+{
+    const auto zero = _mm_setzero_si128();
+    const auto qx = _mm_set1_epi32(q.x);
+    const auto qy = _mm_set1_epi32(q.y);
+    const auto qx2 = _mm_set1_epi32(q.x + q.w);
+    const auto qy2 = _mm_set1_epi32(q.y + q.h);
+    auto count = std::size_t{0};
+    auto i = std::size_t{0};
+    for (; i + 4 <= n; i += 4) {
+        __m128i x, y, w, h;
+        load_rects_sse2(rects + i, x, y, w, h);
+        auto m = _mm_and_si128(_mm_cmpgt_epi32(w, zero), _mm_cmpgt_epi32(h, zero));
+        m = _mm_and_si128(m, _mm_and_si128(_mm_cmpgt_epi32(qx2, x), _mm_cmpgt_epi32(_mm_add_epi32(x, w), qx)));
+        m = _mm_and_si128(m, _mm_and_si128(_mm_cmpgt_epi32(qy2, y), _mm_cmpgt_epi32(_mm_add_epi32(y, h), qy)));
+        const auto bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+        store_mask_bytes(bits, out + i, 4);
+        count += static_cast<std::size_t>(popcount(bits));
+    }
+    return count + are_intersecting_scalar(q, rects, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("sse2")
+inline auto is_point_in_rectangles_sse2(const point& p, const rect* rects, u8* out, std::size_t n) noexcept -> std::size_t
+{
+    const auto px = _mm_set1_epi32(p.x);
+    const auto py = _mm_set1_epi32(p.y);
+    auto count = std::size_t{0};
+    auto i = std::size_t{0};
+    for (; i + 4 <= n; i += 4) {
+        __m128i x, y, w, h;
+        load_rects_sse2(rects + i, x, y, w, h);
+        const auto outside = _mm_or_si128(_mm_cmpgt_epi32(x, px), _mm_cmpgt_epi32(y, py));
+        const auto inside = _mm_and_si128(_mm_cmpgt_epi32(_mm_add_epi32(x, w), px), _mm_cmpgt_epi32(_mm_add_epi32(y, h), py));
+        const auto m = _mm_andnot_si128(outside, inside);
+        const auto bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+        store_mask_bytes(bits, out + i, 4);
+        count += static_cast<std::size_t>(popcount(bits));
+    }
+    return count + is_point_in_rectangles_scalar(p, rects, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("sse2")
+inline void translate_points_sse2(const point* in, const point& offset, point* out, std::size_t n) noexcept
+{
+    const auto o = _mm_setr_epi32(offset.x, offset.y, offset.x, offset.y);
+    auto i = std::size_t{0};
+    for (; i + 2 <= n; i += 2) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(v, o));
+    }
+    translate_points_scalar(in, offset, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("sse2")
+inline void scale_points_sse2(const point* in, float sx, float sy, point* out, std::size_t n) noexcept
+{
+    const auto s = _mm_setr_ps(sx, sy, sx, sy);
+    auto i = std::size_t{0};
+    for (; i + 2 <= n; i += 2) {
+        const auto v = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_cvttps_epi32(_mm_mul_ps(v, s)));
+    }
+    scale_points_scalar(in, sx, sy, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("sse2")
+inline void bounds_sse2(const point* points, std::size_t n, point& min, point& max) noexcept
+{
+    auto lo = _mm_setr_epi32(min.x, min.y, min.x, min.y);
+    auto hi = _mm_setr_epi32(max.x, max.y, max.x, max.y);
+    auto i = std::size_t{0};
+    for (; i + 2 <= n; i += 2) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(points + i));
+        const auto below = _mm_cmpgt_epi32(lo, v);
+        const auto above = _mm_cmpgt_epi32(v, hi);
+        lo = _mm_or_si128(_mm_and_si128(below, v), _mm_andnot_si128(below, lo));
+        hi = _mm_or_si128(_mm_and_si128(above, v), _mm_andnot_si128(above, hi));
+    }
+    alignas(16) int l[4];
+    alignas(16) int h[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(l), lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(h), hi);
+    min = point{std::min(l[0], l[2]), std::min(l[1], l[3])};
+    max = point{std::max(h[0], h[2]), std::max(h[1], h[3])};
+    bounds_scalar(points, i, n, min, max);
+}
+
+// Loads eight rects and transposes them into x, y, w and h vectors, in
+// rect order.
+SDLW_DETAIL_TARGET("avx2")
+inline void load_rects_avx2(const rect* rects, __m256i& x, __m256i& y, __m256i& w, __m256i& h) noexcept
+{
+    const auto l0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects + 0));
+    const auto l1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects + 2));
+    const auto l2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects + 4));
+    const auto l3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects + 6));
+    // Pair rect k with rect k + 4 so the in-lane transpose keeps the order.
+    const auto r0 = _mm256_permute2x128_si256(l0, l2, 0x20);
+    const auto r1 = _mm256_permute2x128_si256(l0, l2, 0x31);
+    const auto r2 = _mm256_permute2x128_si256(l1, l3, 0x20);
+    const auto r3 = _mm256_permute2x128_si256(l1, l3, 0x31);
+    const auto t0 = _mm256_unpacklo_epi32(r0, r1);
+    const auto t1 = _mm256_unpacklo_epi32(r2, r3);
+    const auto t2 = _mm256_unpackhi_epi32(r0, r1);
+    const auto t3 = _mm256_unpackhi_epi32(r2, r3);
+    x = _mm256_unpacklo_epi64(t0, t1);
+    y = _mm256_unpackhi_epi64(t0, t1);
+    w = _mm256_unpacklo_epi64(t2, t3);
+    h = _mm256_unpackhi_epi64(t2, t3);
+}
+
+SDLW_DETAIL_TARGET("avx2")
+inline auto are_intersecting_avx2(const rect& q, const rect* rects, u8* out, std::size_t n) noexcept -> std::size_t
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto qx = _mm256_set1_epi32(q.x);
+    const auto qy = _mm256_set1_epi32(q.y);
+    const auto qx2 = _mm256_set1_epi32(q.x + q.w);
+    const auto qy2 = _mm256_set1_epi32(q.y + q.h);
+    auto count = std::size_t{0};
+    auto i = std::size_t{0};
+    for (; i + 8 <= n; i += 8) {
+        __m256i x, y, w, h;
+        load_rects_avx2(rects + i, x, y, w, h);
+        auto m = _mm256_and_si256(_mm256_cmpgt_epi32(w, zero), _mm256_cmpgt_epi32(h, zero));
+        m = _mm256_and_si256(m, _mm256_and_si256(_mm256_cmpgt_epi32(qx2, x), _mm256_cmpgt_epi32(_mm256_add_epi32(x, w), qx)));
+        m = _mm256_and_si256(m, _mm256_and_si256(_mm256_cmpgt_epi32(qy2, y), _mm256_cmpgt_epi32(_mm256_add_epi32(y, h), qy)));
+        const auto bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+        store_mask_bytes(bits, out + i, 8);
+        count += static_cast<std::size_t>(popcount(bits));
+    }
+    return count + are_intersecting_scalar(q, rects, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("avx2")
+inline auto is_point_in_rectangles_avx2(const point& p, const rect* rects, u8* out, std::size_t n) noexcept -> std::size_t
+{
+    const auto px = _mm256_set1_epi32(p.x);
+    const auto py = _mm256_set1_epi32(p.y);
+    auto count = std::size_t{0};
+    auto i = std::size_t{0};
+    for (; i + 8 <= n; i += 8) {
+        __m256i x, y, w, h;
+        load_rects_avx2(rects + i, x, y, w, h);
+        const auto outside = _mm256_or_si256(_mm256_cmpgt_epi32(x, px), _mm256_cmpgt_epi32(y, py));
+        const auto inside
+            = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_add_epi32(x, w), px), _mm256_cmpgt_epi32(_mm256_add_epi32(y, h), py));
+        const auto m = _mm256_andnot_si256(outside, inside);
+        const auto bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+        store_mask_bytes(bits, out + i, 8);
+        count += static_cast<std::size_t>(popcount(bits));
+    }
+    return count + is_point_in_rectangles_scalar(p, rects, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("avx2")
+inline void translate_points_avx2(const point* in, const point& offset, point* out, std::size_t n) noexcept
+{
+    const auto o = _mm256_setr_epi32(offset.x, offset.y, offset.x, offset.y, offset.x, offset.y, offset.x, offset.y);
+    auto i = std::size_t{0};
+    for (; i + 4 <= n; i += 4) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(v, o));
+    }
+    translate_points_scalar(in, offset, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("avx2")
+inline void scale_points_avx2(const point* in, float sx, float sy, point* out, std::size_t n) noexcept
+{
+    const auto s = _mm256_setr_ps(sx, sy, sx, sy, sx, sy, sx, sy);
+    auto i = std::size_t{0};
+    for (; i + 4 <= n; i += 4) {
+        const auto v = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvttps_epi32(_mm256_mul_ps(v, s)));
+    }
+    scale_points_scalar(in, sx, sy, out, i, n);
+}
+
+SDLW_DETAIL_TARGET("avx2")
+inline void bounds_avx2(const point* points, std::size_t n, point& min, point& max) noexcept
+{
+    auto lo = _mm256_setr_epi32(min.x, min.y, min.x, min.y, min.x, min.y, min.x, min.y);
+    auto hi = _mm256_setr_epi32(max.x, max.y, max.x, max.y, max.x, max.y, max.x, max.y);
+    auto i = std::size_t{0};
+    for (; i + 4 <= n; i += 4) {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points + i));
+        lo = _mm256_min_epi32(lo, v);
+        hi = _mm256_max_epi32(hi, v);
+    }
+    alignas(32) int l[8];
+    alignas(32) int h[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(l), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(h), hi);
+    min = point{std::min({l[0], l[2], l[4], l[6]}), std::min({l[1], l[3], l[5], l[7]})};
+    max = point{std::max({h[0], h[2], h[4], h[6]}), std::max({h[1], h[3], h[5], h[7]})};
+    bounds_scalar(points, i, n, min, max);
+}
+
+#elif defined(SDLW_DETAIL_SIMD_NEON)
+
+inline auto neon_bits(uint32x4_t m) noexcept -> unsigned
+{
+    return (vgetq_lane_u32(m, 0) & 1u) | (vgetq_lane_u32(m, 1) & 2u) | (vgetq_lane_u32(m, 2) & 4u) | (vgetq_lane_u32(m, 3) & 8u);
+}
+
+inline auto are_intersecting_neon(const rect& q, const rect* rects, u8* out, std::size_t n) noexcept -> std::size_t
+{
+    const auto zero = vdupq_n_s32(0);
+    const auto qx = vdupq_n_s32(q.x);
+    const auto qy = vdupq_n_s32(q.y);
+    const auto qx2 = vdupq_n_s32(q.x + q.w);
+    const auto qy2 = vdupq_n_s32(q.y + q.h);
+    auto count = std::size_t{0};
+    auto i = std::size_t{0};
+    for (; i + 4 <= n; i += 4) {
+        const auto r = vld4q_s32(reinterpret_cast<const int32_t*>(rects + i));
+        const auto x = r.val[0], y = r.val[1], w = r.val[2], h = r.val[3];
+        auto m = vandq_u32(vcgtq_s32(w, zero), vcgtq_s32(h, zero));
+        m = vandq_u32(m, vandq_u32(vcltq_s32(x, qx2), vcgtq_s32(vaddq_s32(x, w), qx)));
+        m = vandq_u32(m, vandq_u32(vcltq_s32(y, qy2), vcgtq_s32(vaddq_s32(y, h), qy)));
+        const auto bits = neon_bits(m);
+        store_mask_bytes(bits, out + i, 4);
+        count += static_cast<std::size_t>(popcount(bits));
+    }
+    return count + are_intersecting_scalar(q, rects, out, i, n);
+}
+
+inline auto is_point_in_rectangles_neon(const point& p, const rect* rects, u8* out, std::size_t n) noexcept -> std::size_t
+{
+    const auto px = vdupq_n_s32(p.x);
+    const auto py = vdupq_n_s32(p.y);
+    auto count = std::size_t{0};
+    auto i = std::size_t{0};
+    for (; i + 4 <= n; i += 4) {
+        const auto r = vld4q_s32(reinterpret_cast<const int32_t*>(rects + i));
+        const auto x = r.val[0], y = r.val[1], w = r.val[2], h = r.val[3];
+        auto m = vandq_u32(vcleq_s32(x, px), vcleq_s32(y, py));
+        m = vandq_u32(m, vandq_u32(vcgtq_s32(vaddq_s32(x, w), px), vcgtq_s32(vaddq_s32(y, h), py)));
+        const auto bits = neon_bits(m);
+        store_mask_bytes(bits, out + i, 4);
+        count += static_cast<std::size_t>(popcount(bits));
+    }
+    return count + is_point_in_rectangles_scalar(p, rects, out, i, n);
+}
+
+inline void translate_points_neon(const point* in, const point& offset, point* out, std::size_t n) noexcept
+{
+    const int32_t o_lanes[4] = {offset.x, offset.y, offset.x, offset.y};
+    const auto o = vld1q_s32(o_lanes);
+    auto i = std::size_t{0};
+    for (; i + 2 <= n; i += 2) {
+        const auto v = vld1q_s32(reinterpret_cast<const int32_t*>(in + i));
+        vst1q_s32(reinterpret_cast<int32_t*>(out + i), vaddq_s32(v, o));
+    }
+    translate_points_scalar(in, offset, out, i, n);
+}
+
+inline void scale_points_neon(const point* in, float sx, float sy, point* out, std::size_t n) noexcept
+{
+    const float s_lanes[4] = {sx, sy, sx, sy};
+    const auto s = vld1q_f32(s_lanes);
+    auto i = std::size_t{0};
+    for (; i + 2 <= n; i += 2) {
+        const auto v = vcvtq_f32_s32(vld1q_s32(reinterpret_cast<const int32_t*>(in + i)));
+        vst1q_s32(reinterpret_cast<int32_t*>(out + i), vcvtq_s32_f32(vmulq_f32(v, s)));
+    }
+    scale_points_scalar(in, sx, sy, out, i, n);
+}
+
+inline void bounds_neon(const point* points, std::size_t n, point& min, point& max) noexcept
+{
+    const int32_t lo_lanes[4] = {min.x, min.y, min.x, min.y};
+    const int32_t hi_lanes[4] = {max.x, max.y, max.x, max.y};
+    auto lo = vld1q_s32(lo_lanes);
+    auto hi = vld1q_s32(hi_lanes);
+    auto i = std::size_t{0};
+    for (; i + 2 <= n; i += 2) {
+        const auto v = vld1q_s32(reinterpret_cast<const int32_t*>(points + i));
+        lo = vminq_s32(lo, v);
+        hi = vmaxq_s32(hi, v);
+    }
+    min = point{std::min(vgetq_lane_s32(lo, 0), vgetq_lane_s32(lo, 2)), std::min(vgetq_lane_s32(lo, 1), vgetq_lane_s32(lo, 3))};
+    max = point{std::max(vgetq_lane_s32(hi, 0), vgetq_lane_s32(hi, 2)), std::max(vgetq_lane_s32(hi, 1), vgetq_lane_s32(hi, 3))};
+    bounds_scalar(points, i, n, min, max);
+}
+
+#endif
+
+} // namespace detail
+
+// Batched versions of the per-pair calls in rect.hpp, vectorized with
+// SSE2, AVX2 or NEON when available. results must be at least as long as
+// the input and receives 1 for a hit and 0 otherwise; the return value is
+// the number of hits. Coordinates are assumed not to overflow int when a
+// size is added to a position, as in SDL itself.
+
+// Same test as are_intersecting(q, rects[i]) for every i.
+inline auto are_intersecting(const rect& q, span<const rect> rects, span<u8> results) noexcept -> std::size_t
+{
+    SDL_ASSERT(results.size() >= rects.size());
+    const auto n = static_cast<std::size_t>(rects.size());
+    if (q.w <= 0 || q.h <= 0) {
+        std::fill_n(results.data(), n, u8{0});
+        return 0;
+    }
+    switch (detail::simd_support()) {
+#if defined(SDLW_DETAIL_SIMD_X86)
+    case detail::simd_level::avx2: return detail::are_intersecting_avx2(q, rects.data(), results.data(), n);
+    case detail::simd_level::ssse3:
+    case detail::simd_level::sse2: return detail::are_intersecting_sse2(q, rects.data(), results.data(), n);
+#elif defined(SDLW_DETAIL_SIMD_NEON)
+    case detail::simd_level::neon: return detail::are_intersecting_neon(q, rects.data(), results.data(), n);
+#endif
+    default: return detail::are_intersecting_scalar(q, rects.data(), results.data(), 0, n);
+    }
+}
+
+// Same test as is_point_in_rectangle(p, rects[i]) for every i.
+inline auto is_point_in_rectangles(const point& p, span<const rect> rects, span<u8> results) noexcept -> std::size_t
+{
+    SDL_ASSERT(results.size() >= rects.size());
+    const auto n = static_cast<std::size_t>(rects.size());
+    switch (detail::simd_support()) {
+#if defined(SDLW_DETAIL_SIMD_X86)
+    case detail::simd_level::avx2: return detail::is_point_in_rectangles_avx2(p, rects.data(), results.data(), n);
+    case detail::simd_level::ssse3:
+    case detail::simd_level::sse2: return detail::is_point_in_rectangles_sse2(p, rects.data(), results.data(), n);
+#elif defined(SDLW_DETAIL_SIMD_NEON)
+    case detail::simd_level::neon: return detail::is_point_in_rectangles_neon(p, rects.data(), results.data(), n);
+#endif
+    default: return detail::is_point_in_rectangles_scalar(p, rects.data(), results.data(), 0, n);
+    }
+}
+
+// out[i] = points[i] + offset. out may be the same buffer as points.
+inline void translate_points(span<const point> points, const point& offset, span<point> out) noexcept
+{
+    SDL_ASSERT(out.size() >= points.size());
+    const auto n = static_cast<std::size_t>(points.size());
+    switch (detail::simd_support()) {
+#if defined(SDLW_DETAIL_SIMD_X86)
+    case detail::simd_level::avx2: detail::translate_points_avx2(points.data(), offset, out.data(), n); break;
+    case detail::simd_level::ssse3:
+    case detail::simd_level::sse2: detail::translate_points_sse2(points.data(), offset, out.data(), n); break;
+#elif defined(SDLW_DETAIL_SIMD_NEON)
+    case detail::simd_level::neon: detail::translate_points_neon(points.data(), offset, out.data(), n); break;
+#endif
+    default: detail::translate_points_scalar(points.data(), offset, out.data(), 0, n); break;
+    }
+}
+
+// out[i] = points[i] * (sx, sy), computed in float and truncated toward
+// zero. Exact for coordinates up to 2^24. out may be the same buffer as
+// points.
+inline void scale_points(span<const point> points, float sx, float sy, span<point> out) noexcept
+{
+    SDL_ASSERT(out.size() >= points.size());
+    const auto n = static_cast<std::size_t>(points.size());
+    switch (detail::simd_support()) {
+#if defined(SDLW_DETAIL_SIMD_X86)
+    case detail::simd_level::avx2: detail::scale_points_avx2(points.data(), sx, sy, out.data(), n); break;
+    case detail::simd_level::ssse3:
+    case detail::simd_level::sse2: detail::scale_points_sse2(points.data(), sx, sy, out.data(), n); break;
+#elif defined(SDLW_DETAIL_SIMD_NEON)
+    case detail::simd_level::neon: detail::scale_points_neon(points.data(), sx, sy, out.data(), n); break;
+#endif
+    default: detail::scale_points_scalar(points.data(), sx, sy, out.data(), 0, n); break;
+    }
+}
+
+// Smallest rect containing every point, as enclose_points(points, nullptr)
+// computes it. Empty input yields nullopt.
+inline auto enclose_points(span<const point> points) noexcept -> std::optional<rect>
+{
+    if (points.empty()) return std::nullopt;
+    const auto n = static_cast<std::size_t>(points.size());
+    auto min = points[0];
+    auto max = points[0];
+    switch (detail::simd_support()) {
+#if defined(SDLW_DETAIL_SIMD_X86)
+    case detail::simd_level::avx2: detail::bounds_avx2(points.data(), n, min, max); break;
+    case detail::simd_level::ssse3:
+    case detail::simd_level::sse2: detail::bounds_sse2(points.data(), n, min, max); break;
+#elif defined(SDLW_DETAIL_SIMD_NEON)
+    case detail::simd_level::neon: detail::bounds_neon(points.data(), n, min, max); break;
+#endif
+    default: detail::bounds_scalar(points.data(), 0, n, min, max); break;
+    }
+    return rect{min.x, min.y, max.x - min.x + 1, max.y - min.y + 1};
+}
+
+} // namespace sdl
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+#include <SDL2/SDL_ttf.h>
+
+#include <sdlw/atlas.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/sprite_batch.hpp>
+#include <sdlw/ttf.hpp>
+
+namespace sdl::ttf {
+
+namespace detail {
+
+// Decodes one UTF-8 sequence starting at *text and advances past it. Code
+// points outside the BMP (and malformed input) map to U+FFFD, since the
+// SDL_ttf glyph API takes 16-bit code points.
+inline auto next_utf8_code_point(const char*& text) noexcept -> u16
+{
+    const auto lead = static_cast<unsigned char>(*text++);
+    if (lead < 0x80) return lead;
+    auto extra = 0;
+    auto cp = u32{};
+    if ((lead & 0xE0) == 0xC0) {
+        extra = 1;
+        cp = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        extra = 2;
+        cp = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        extra = 3;
+        cp = lead & 0x07;
+    } else {
+        return 0xFFFD;
+    }
+    for (; extra > 0; --extra) {
+        const auto c = static_cast<unsigned char>(*text);
+        if ((c & 0xC0) != 0x80) return 0xFFFD;
+        cp = (cp << 6) | (c & 0x3F);
+        ++text;
+    }
+    return cp <= 0xFFFF ? static_cast<u16>(cp) : u16{0xFFFD};
+}
+
+} // namespace detail
+
+// Rasterizes each glyph once per (font, style, outline) into shared atlas
+// pages, white, so that text color is applied as a vertex/texture mod and
+// steady-state drawing performs no allocations and no uploads.
+class glyph_cache {
+public:
+    struct glyph {
+        sub_texture image;
+        sdl::size image_size;
+        ttf::glyph_metrics metrics;
+    };
+
+    explicit glyph_cache(renderer& r, const sdl::size& page_size = {512, 512})
+        : _atlas{r, page_size, 1}
+    {
+        _atlas.release_sources();
+    }
+
+    auto get(const font& f, u16 ch) -> const glyph&
+    {
+        auto& glyphs = face_for(f);
+        if (const auto it = glyphs.find(ch); it != glyphs.end()) {
+            return it->second;
+        }
+        return glyphs.emplace(ch, rasterize(f, ch)).first->second;
+    }
+
+    // Size of the text as draw() lays it out: '\n' starts a new line
+    // line_skip() below the previous one.
+    auto measure(const font& f, const char* utf8) -> sdl::size
+    {
+        auto width = 0;
+        auto line_width = 0;
+        auto lines = 1;
+        auto prev = u16{0};
+        const auto kerning = f.is_kerning_allowed();
+        while (*utf8) {
+            const auto ch = detail::next_utf8_code_point(utf8);
+            if (ch == '\n') {
+                width = std::max(width, line_width);
+                line_width = 0;
+                ++lines;
+                prev = 0;
+                continue;
+            }
+            if (kerning && prev) line_width += kerning_offset(f, prev, ch);
+            line_width += get(f, ch).metrics.advance;
+            prev = ch;
+        }
+        return {std::max(width, line_width), (lines - 1) * f.line_skip() + f.height()};
+    }
+
+    // Queues one quad per visible glyph; the caller flushes the batch.
+    void draw(sprite_batch& batch, const font& f, const char* utf8, const point& position, color c)
+    {
+        auto pen = position;
+        auto prev = u16{0};
+        const auto kerning = f.is_kerning_allowed();
+        while (*utf8) {
+            const auto ch = detail::next_utf8_code_point(utf8);
+            if (ch == '\n') {
+                pen.x = position.x;
+                pen.y += f.line_skip();
+                prev = 0;
+                continue;
+            }
+            if (kerning && prev) pen.x += kerning_offset(f, prev, ch);
+            const auto& g = get(f, ch);
+            if (g.image) {
+                const auto dst = rect{pen.x, pen.y, g.image_size.w, g.image_size.h};
+                batch.draw(g.image, dst, c);
+            }
+            pen.x += g.metrics.advance;
+            prev = ch;
+        }
+    }
+
+    // Drops every glyph cached for f. Call it before closing a font: the
+    // cache is keyed by the TTF_Font pointer, and a font opened later at
+    // the same address would otherwise be served stale glyphs. Their atlas
+    // space is not reclaimed.
+    void forget(const font& f) noexcept
+    {
+        const auto pointer = f.get_pointer();
+        for (auto it = _faces.begin(); it != _faces.end();) {
+            it = std::get<0>(it->first) == pointer ? _faces.erase(it) : std::next(it);
+        }
+        _last_key = {};
+        _last_face = nullptr;
+    }
+
+    auto glyph_count() const noexcept -> std::size_t
+    {
+        auto count = std::size_t{0};
+        for (const auto& [key, glyphs] : _faces) count += glyphs.size();
+        return count;
+    }
+
+    auto page_count() const noexcept -> std::size_t
+    {
+        return _atlas.page_count();
+    }
+
+private:
+    using face_key = std::tuple<TTF_Font*, int, int>;
+    using glyph_table = std::unordered_map<u16, glyph>;
+
+    auto face_for(const font& f) -> glyph_table&
+    {
+        const auto key = face_key{f.get_pointer(), static_cast<int>(f.style()), f.outline()};
+        if (_last_face && _last_key == key) {
+            return *_last_face;
+        }
+        _last_key = key;
+        _last_face = &_faces[key];
+        return *_last_face;
+    }
+
+    static auto kerning_offset(const font& f, u16 prev, u16 ch) noexcept -> int
+    {
+#if defined(SDL_TTF_VERSION_ATLEAST)
+#    if SDL_TTF_VERSION_ATLEAST(2, 0, 14)
+        return TTF_GetFontKerningSizeGlyphs(f.get_pointer(), prev, ch);
+#    else
+        return 0;
+#    endif
+#else
+        return 0;
+#endif
+    }
+
+    auto rasterize(const font& f, u16 ch) -> glyph
+    {
+        auto g = glyph{};
+        g.metrics = f.glyph_metrics(ch);
+        if (g.metrics.maxx <= g.metrics.minx && f.outline() == 0) {
+            return g; // nothing visible, e.g. a space
+        }
+        const auto image = blended_glyph_render(f, ch, color{255, 255, 255, 255});
+        g.image_size = image.size();
+        g.image = _atlas[_atlas.insert(image)];
+        return g;
+    }
+
+    atlas _atlas;
+    std::map<face_key, glyph_table> _faces;
+    face_key _last_key = {};
+    glyph_table* _last_face = nullptr;
+};
+
+} // namespace sdl::ttf
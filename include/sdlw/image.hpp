@@ -3,6 +3,7 @@
 #include <SDL2/SDL_image.h>
 
 #include <sdlw/render.hpp>
+#include <sdlw/rwops.hpp>
 #include <sdlw/surface.hpp>
 
 #include "sdlw/detail/utility.hpp"
@@ -22,7 +23,7 @@ struct subsystem {
     explicit subsystem(subsystem::flags flags)
     {
         if (IMG_Init(static_cast<int>(flags)) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -39,7 +40,16 @@ inline auto load_as_surface(const char* filename) -> surface
     if (const auto psurface = IMG_Load(filename)) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto load_as_surface(stream& s) -> surface
+{
+    if (const auto psurface = IMG_Load_RW(s.get_pointer(), 0)) {
+        return surface{psurface};
+    } else {
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -49,21 +59,26 @@ inline auto load_as_texture(const renderer& rend, const char* filename) -> textu
     if (ptexture) {
         return texture{ptexture};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
 inline void save_as_png(const surface& surf, const char* filename)
 {
     if (IMG_SavePNG(surf.get_pointer(), filename) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto save_as_png(const surface& surf, const char* filename, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(IMG_SavePNG(surf.get_pointer(), filename));
+}
+
 inline void save_as_jpg(const surface& surf, const char* filename, int quality)
 {
     if (IMG_SaveJPG(surf.get_pointer(), filename, quality) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -85,14 +85,14 @@ public:
     explicit joystick(int device_index)
         : _joystick{SDL_JoystickOpen(device_index)}
     {
-        if (!_joystick) throw error{};
+        if (!_joystick) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto power_level() const -> joystick_power_level
     {
         const auto pl = SDL_JoystickCurrentPowerLevel(_joystick.get());
         if (pl == SDL_JOYSTICK_POWER_UNKNOWN) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return static_cast<joystick_power_level>(pl);
         }
@@ -114,7 +114,7 @@ public:
         auto dx = int{};
         auto dy = int{};
         if (SDL_JoystickGetBall(_joystick.get(), ball, &dx, &dy) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
         return {dx, dy};
     }
@@ -138,42 +138,42 @@ public:
     auto id() const -> joystick_id
     {
         const auto result = SDL_JoystickInstanceID(_joystick.get());
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
     auto name() const -> const char*
     {
         const auto result = SDL_JoystickName(_joystick.get());
-        if (!result) throw error{};
+        if (!result) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
     auto num_axes() const -> int
     {
         const auto result = SDL_JoystickNumAxes(_joystick.get());
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
     auto num_balls() const -> int
     {
         const auto result = SDL_JoystickNumBalls(_joystick.get());
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
     auto num_buttons() const -> int
     {
         const auto result = SDL_JoystickNumButtons(_joystick.get());
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
     auto num_hats() const -> int
     {
         const auto result = SDL_JoystickNumHats(_joystick.get());
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
@@ -181,7 +181,7 @@ public:
     {
         const auto result = SDL_JoystickEventState(SDL_QUERY);
         if (result < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return result;
         }
@@ -197,7 +197,7 @@ public:
     static auto get_name(int device_index) -> const char*
     {
         const auto result = SDL_JoystickNameForIndex(device_index);
-        if (!result) throw error{};
+        if (!result) SDLW_DETAIL_THROW_ERROR();
         return result;
     }
 
@@ -231,7 +231,7 @@ inline auto joystick_device_guid(int device_index) noexcept -> joystick_guid
 inline auto num_joysticks() -> int
 {
     const auto result = SDL_NumJoysticks();
-    if (result < 0) throw error{};
+    if (result < 0) SDLW_DETAIL_THROW_ERROR();
     return result;
 }
 
@@ -42,7 +42,7 @@ public:
 inline auto to_keycode(const char* name) -> keycode
 {
     if (const auto result = SDL_GetKeyFromName(name); result == SDLK_UNKNOWN) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return static_cast<keycode>(result);
     }
@@ -64,7 +64,7 @@ inline auto to_scancode(const char* name) -> scancode
 {
     const auto result = SDL_GetScancodeFromName(name);
     if (result == SDL_SCANCODE_UNKNOWN) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return static_cast<scancode>(result);
     }
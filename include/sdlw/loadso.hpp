@@ -15,7 +15,7 @@ public:
     explicit shared_object(const char* sofile)
         : _shared_object{SDL_LoadObject(sofile)}
     {
-        if (!_shared_object) throw error{};
+        if (!_shared_object) SDLW_DETAIL_THROW_ERROR();
     }
 
     template<typename Function>
@@ -24,7 +24,7 @@ public:
         if (const auto fp = SDL_LoadFunction(_shared_object.get(), name)) {
             return reinterpret_cast<Function*>(fp);
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
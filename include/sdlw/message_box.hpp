@@ -21,7 +21,7 @@ inline void show_simple_message_box(message_box::flags f, const char* title, con
 {
     const auto flag = static_cast<u32>(f);
     if (SDL_ShowSimpleMessageBox(flag, title, message, nullptr) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -30,7 +30,7 @@ inline void show_simple_message_box(message_box::flags f, const char* title, con
     const auto flag = static_cast<u32>(f);
     const auto pwindow = parent.get_pointer();
     if (SDL_ShowSimpleMessageBox(flag, title, message, pwindow) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
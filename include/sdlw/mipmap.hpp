@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <new>
+#include <vector>
+
+#include <SDL2/SDL_render.h>
+#include <SDL2/SDL_surface.h>
+
+#include <sdlw/atlas.hpp>
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/surface.hpp>
+
+#include "sdlw/detail/simd.hpp"
+
+namespace sdl {
+
+// clang-format off
+
+// How mip levels average color channels. srgb averages the stored values
+// directly, which is fast but darkens fine high-contrast detail; linear
+// decodes sRGB to linear light first and keeps brightness. Either way each
+// color is weighted by its pixel's alpha, so the colors of transparent
+// pixels do not bleed into visible neighbours; levels stay straight alpha.
+// Alpha itself is averaged as stored.
+enum class mip_space {
+    srgb,
+    linear
+};
+
+// clang-format on
+
+namespace detail {
+
+// Linear light in 16 bits for each sRGB byte.
+inline auto srgb_to_linear_table() noexcept -> const std::array<u16, 256>&
+{
+    static const auto table = [] {
+        auto t = std::array<u16, 256>{};
+        for (auto i = 0; i < 256; ++i) {
+            const auto c = i / 255.0;
+            const auto l = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+            t[static_cast<std::size_t>(i)] = static_cast<u16>(std::lround(l * 65535.0));
+        }
+        return t;
+    }();
+    return table;
+}
+
+// sRGB byte for the top 12 bits of a 16-bit linear value.
+inline auto linear_to_srgb_table() noexcept -> const std::array<u8, 4096>&
+{
+    static const auto table = [] {
+        auto t = std::array<u8, 4096>{};
+        for (auto i = 0; i < 4096; ++i) {
+            const auto l = (i + 0.5) / 4096.0;
+            const auto c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+            t[static_cast<std::size_t>(i)] = static_cast<u8>(std::lround(std::clamp(c, 0.0, 1.0) * 255.0));
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Averages the 2x2 block under each output pixel of an ARGB8888 row, from
+// output column first on. Source columns and rows past the edge repeat the
+// last one, so a 1-pixel-wide level still halves the other way. Colors are
+// (sum of c * a + A / 2) / A over the block's alpha sum A, which reduces to
+// the plain (sum of c + 2) / 4 when all four alphas are equal; that case,
+// and A == 0, skips the division.
+inline void downsample_row_scalar(
+    const u32* row0, const u32* row1, int src_w, u32* dst, int first, int dst_w, mip_space space) noexcept
+{
+    const auto& decode = srgb_to_linear_table();
+    const auto& encode = linear_to_srgb_table();
+    for (auto x = first; x < dst_w; ++x) {
+        const auto x0 = 2 * x;
+        const auto x1 = std::min(x0 + 1, src_w - 1);
+        const u32 p[] = {row0[x0], row0[x1], row1[x0], row1[x1]};
+        const u32 a[] = {p[0] >> 24, p[1] >> 24, p[2] >> 24, p[3] >> 24};
+        const auto alpha = a[0] + a[1] + a[2] + a[3];
+        const auto weighted = a[0] != a[1] || a[0] != a[2] || a[0] != a[3];
+        auto out = (alpha + 2) / 4 << 24;
+        for (auto shift = 0; shift < 24; shift += 8) {
+            auto sum = u32{0};
+            for (auto i = 0; i < 4; ++i) {
+                const auto c = (p[i] >> shift) & 0xFF;
+                const auto v = space == mip_space::srgb ? c : u32{decode[c]};
+                sum += weighted ? v * a[i] : v;
+            }
+            const auto v = weighted ? (sum + alpha / 2) / alpha : (sum + 2) / 4;
+            out |= (space == mip_space::srgb ? v : u32{encode[v >> 4]}) << shift;
+        }
+        dst[x] = out;
+    }
+}
+
+#if defined(SDLW_DETAIL_SIMD_X86)
+
+// Both kernels average (a + b + c + d + 2) / 4 per channel, which is what
+// the scalar path computes for blocks of equal alpha. They handle the srgb
+// space on sources at least two pixels wide, take whole groups of source
+// pixels that are all opaque or all transparent, and hand any other group
+// to the scalar path. They return how many output pixels they wrote.
+
+// Four source pixels from each of two rows to two averaged ones, in
+// 16-bit lanes.
+SDLW_DETAIL_TARGET("sse2") inline auto halve_sse2(__m128i a, __m128i b) noexcept -> __m128i
+{
+    const auto zero = _mm_setzero_si128();
+    const auto lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+    const auto hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+    const auto sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+
+SDLW_DETAIL_TARGET("sse2")
+inline auto downsample_row_sse2(const u32* row0, const u32* row1, int src_w, u32* dst, int dst_w) noexcept -> int
+{
+    const auto alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    const auto zero = _mm_setzero_si128();
+    auto x = 0;
+    for (; x + 4 <= dst_w; x += 4) {
+        const auto a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 2 * x));
+        const auto a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 2 * x + 4));
+        const auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 2 * x));
+        const auto b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 2 * x + 4));
+        const auto all = _mm_and_si128(_mm_and_si128(a0, a1), _mm_and_si128(b0, b1));
+        const auto any = _mm_or_si128(_mm_or_si128(a0, a1), _mm_or_si128(b0, b1));
+        const auto opaque = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, alpha), alpha)) == 0xFFFF;
+        const auto clear = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, alpha), zero)) == 0xFFFF;
+        if (!opaque && !clear) {
+            downsample_row_scalar(row0, row1, src_w, dst, x, x + 4, mip_space::srgb);
+            continue;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(halve_sse2(a0, b0), halve_sse2(a1, b1)));
+    }
+    return x;
+}
+
+// Same as halve_sse2 within each 128-bit lane.
+SDLW_DETAIL_TARGET("avx2") inline auto halve_avx2(__m256i a, __m256i b) noexcept -> __m256i
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+    const auto hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+    const auto sum = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+    return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(2)), 2);
+}
+
+SDLW_DETAIL_TARGET("avx2")
+inline auto downsample_row_avx2(const u32* row0, const u32* row1, int src_w, u32* dst, int dst_w) noexcept -> int
+{
+    const auto alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    const auto zero = _mm256_setzero_si256();
+    auto x = 0;
+    for (; x + 8 <= dst_w; x += 8) {
+        const auto a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + 2 * x));
+        const auto a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + 2 * x + 8));
+        const auto b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + 2 * x));
+        const auto b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + 2 * x + 8));
+        const auto all = _mm256_and_si256(_mm256_and_si256(a0, a1), _mm256_and_si256(b0, b1));
+        const auto any = _mm256_or_si256(_mm256_or_si256(a0, a1), _mm256_or_si256(b0, b1));
+        const auto opaque = _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(all, alpha), alpha)) == -1;
+        const auto clear = _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(any, alpha), zero)) == -1;
+        if (!opaque && !clear) {
+            downsample_row_scalar(row0, row1, src_w, dst, x, x + 8, mip_space::srgb);
+            continue;
+        }
+        // Packing interleaves the lanes; put the 64-bit pairs back in order.
+        const auto packed = _mm256_packus_epi16(halve_avx2(a0, b0), halve_avx2(a1, b1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    return x;
+}
+
+#endif
+
+inline void downsample_row(const u32* row0, const u32* row1, int src_w, u32* dst, int dst_w, mip_space space) noexcept
+{
+    auto done = 0;
+#if defined(SDLW_DETAIL_SIMD_X86)
+    if (space == mip_space::srgb && src_w >= 2) {
+        const auto level = simd_support();
+        if (level == simd_level::avx2) done = downsample_row_avx2(row0, row1, src_w, dst, dst_w);
+        if (level >= simd_level::sse2) {
+            done += downsample_row_sse2(row0 + 2 * done, row1 + 2 * done, src_w - 2 * done, dst + done, dst_w - done);
+        }
+    }
+#endif
+    downsample_row_scalar(row0, row1, src_w, dst, done, dst_w, space);
+}
+
+inline void downsample(const surface& src, surface& dst, mip_space space) noexcept
+{
+    const auto s = src.get_pointer();
+    const auto d = dst.get_pointer();
+    const auto row = [](SDL_Surface* p, int y) {
+        return reinterpret_cast<u32*>(static_cast<u8*>(p->pixels) + static_cast<std::ptrdiff_t>(y) * p->pitch);
+    };
+    for (auto y = 0; y < d->h; ++y) {
+        const auto y0 = 2 * y;
+        downsample_row(row(s, y0), row(s, std::min(y0 + 1, s->h - 1)), s->w, row(d, y), d->w, space);
+    }
+}
+
+} // namespace detail
+
+// A surface and its successively halved copies down to 1x1, in ARGB8888.
+// Each level averages 2x2 blocks of the one above; odd sizes round down,
+// dropping the last row or column of the larger level.
+class mip_chain {
+public:
+    explicit mip_chain(const surface& s, mip_space space = mip_space::srgb)
+    {
+        _levels.push_back(to_argb8888(s));
+
+        for (auto sz = s.size(); sz.w > 1 || sz.h > 1;) {
+            sz = {std::max(sz.w / 2, 1), std::max(sz.h / 2, 1)};
+            auto level = surface{sz.w, sz.h, 32, pixel_format_type::argb8888};
+            detail::downsample(_levels.back(), level, space);
+            _levels.push_back(std::move(level));
+        }
+    }
+
+    auto level_count() const noexcept -> int
+    {
+        return static_cast<int>(_levels.size());
+    }
+
+    auto level(int i) const noexcept -> const surface&
+    {
+        return _levels[static_cast<std::size_t>(i)];
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _levels.front().size();
+    }
+
+private:
+    std::vector<surface> _levels;
+};
+
+// The level to sample when src_size pixels cover dst_size pixels on
+// screen: the smallest level still at least as large as the destination
+// along its more shrunk axis, so sampling it never skips texels.
+inline auto mip_level_for(const sdl::size& src_size, float dst_w, float dst_h, int level_count) noexcept -> int
+{
+    if (dst_w <= 0.0f || dst_h <= 0.0f) return 0;
+    auto ratio = std::max(src_size.w / dst_w, src_size.h / dst_h);
+    auto level = 0;
+    for (; ratio >= 2.0f && level + 1 < level_count; ratio *= 0.5f) {
+        ++level;
+    }
+    return level;
+}
+
+// The levels of a mip_chain on the GPU, either one texture per level or
+// packed into an atlas. Use copy() below to draw with the level matching
+// the destination size.
+class mip_texture {
+public:
+    mip_texture(const renderer& r, const mip_chain& chain)
+    {
+        for (auto i = 0; i < chain.level_count(); ++i) {
+            _textures.emplace_back(r, chain.level(i));
+            _sizes.push_back(chain.level(i).size());
+        }
+    }
+
+    // The atlas must outlive the mip_texture. Levels are fetched from it
+    // on every draw, so repacking the atlas is fine.
+    mip_texture(atlas& a, const mip_chain& chain)
+        : _atlas{&a}
+    {
+        for (auto i = 0; i < chain.level_count(); ++i) {
+            _ids.push_back(a.insert(chain.level(i)));
+            _sizes.push_back(chain.level(i).size());
+        }
+    }
+
+    auto level_count() const noexcept -> int
+    {
+        return static_cast<int>(_sizes.size());
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _sizes.front();
+    }
+
+    auto level(int i) const -> sub_texture
+    {
+        const auto index = static_cast<std::size_t>(i);
+        if (_atlas) return (*_atlas)[_ids[index]];
+        return sub_texture{&_textures[index].ref(), rect{0, 0, _sizes[index].w, _sizes[index].h}};
+    }
+
+    // The part of the level to draw for src, given in level 0 pixels, when
+    // it lands on dst_w x dst_h screen pixels. A null src means the whole
+    // image.
+    auto select(const rect* src, float dst_w, float dst_h) const -> sub_texture
+    {
+        const auto base = size();
+        const auto area = src ? *src : rect{0, 0, base.w, base.h};
+        const auto i = mip_level_for({area.w, area.h}, dst_w, dst_h, level_count());
+        auto st = level(i);
+        if (src) {
+            const auto sz = _sizes[static_cast<std::size_t>(i)];
+            const auto x0 = area.x * sz.w / base.w;
+            const auto y0 = area.y * sz.h / base.h;
+            const auto x1 = (area.x + area.w) * sz.w / base.w;
+            const auto y1 = (area.y + area.h) * sz.h / base.h;
+            st.area = rect{st.area.x + x0, st.area.y + y0, std::max(x1 - x0, 1), std::max(y1 - y0, 1)};
+        }
+        return st;
+    }
+
+private:
+    std::vector<texture> _textures;
+    atlas* _atlas = nullptr;
+    std::vector<atlas::id> _ids;
+    std::vector<sdl::size> _sizes;
+};
+
+namespace detail {
+
+// dst size in output pixels, after the renderer's scale.
+inline auto mip_select(const renderer& r, const mip_texture& m, const rect* src, float dst_w, float dst_h) -> sub_texture
+{
+    auto sx = 1.0f;
+    auto sy = 1.0f;
+    SDL_RenderGetScale(r.get_pointer(), &sx, &sy);
+    return m.select(src, dst_w * sx, dst_h * sy);
+}
+
+} // namespace detail
+
+// Draws src, in level 0 pixels, of m onto dst using the level that best
+// matches the on-screen size of dst.
+inline void copy(renderer& r, const mip_texture& m, const rect* src, const rect& dst)
+{
+    const auto st = detail::mip_select(r, m, src, static_cast<float>(dst.w), static_cast<float>(dst.h));
+    r.copy(st, &dst);
+}
+
+inline auto copy(renderer& r, const mip_texture& m, const rect* src, const rect& dst, std::nothrow_t) noexcept -> status
+{
+    const auto st = detail::mip_select(r, m, src, static_cast<float>(dst.w), static_cast<float>(dst.h));
+    return r.copy(st, &dst, std::nothrow);
+}
+
+#if SDLW_DETAIL_HAS_FLOAT_RECT
+inline void copy(renderer& r, const mip_texture& m, const rect* src, const frect& dst)
+{
+    r.copy(detail::mip_select(r, m, src, dst.w, dst.h), dst);
+}
+
+inline auto copy(renderer& r, const mip_texture& m, const rect* src, const frect& dst, std::nothrow_t) noexcept -> status
+{
+    return r.copy(detail::mip_select(r, m, src, dst.w, dst.h), dst, std::nothrow);
+}
+#endif
+
+} // namespace sdl
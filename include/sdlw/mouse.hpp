@@ -41,19 +41,19 @@ public:
     cursor(const u8* data, const u8* mask, const size& sz, const point& topleft_corner)
         : cursor{SDL_CreateCursor(data, mask, sz.w, sz.h, topleft_corner.x, topleft_corner.y)}
     {
-        if (!_cursor) throw error{};
+        if (!_cursor) SDLW_DETAIL_THROW_ERROR();
     }
 
     cursor(const surface& surf, const point& topleft_corner)
         : cursor{SDL_CreateColorCursor(surf.get_pointer(), topleft_corner.x, topleft_corner.y)}
     {
-        if (!_cursor) throw error{};
+        if (!_cursor) SDLW_DETAIL_THROW_ERROR();
     }
 
     explicit cursor(system_cursor sysc)
         : cursor{SDL_CreateSystemCursor(static_cast<SDL_SystemCursor>(sysc))}
     {
-        if (!_cursor) throw error{};
+        if (!_cursor) SDLW_DETAIL_THROW_ERROR();
     }
 
 protected:
@@ -86,20 +86,20 @@ struct active_cursor {
     static auto is_shown() -> bool
     {
         const auto result = SDL_ShowCursor(SDL_QUERY);
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
         return static_cast<bool>(result);
     }
 
     static void show()
     {
         const auto result = SDL_ShowCursor(SDL_ENABLE);
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
     }
 
     static void hide()
     {
         const auto result = SDL_ShowCursor(SDL_DISABLE);
-        if (result < 0) throw error{};
+        if (result < 0) SDLW_DETAIL_THROW_ERROR();
     }
 };
 
@@ -180,14 +180,14 @@ struct relative_mouse_mode {
     static void enable()
     {
         if (SDL_SetRelativeMouseMode(SDL_TRUE) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
     static void disable()
     {
         if (SDL_SetRelativeMouseMode(SDL_FALSE) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
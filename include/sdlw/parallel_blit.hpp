@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <SDL2/SDL_surface.h>
+#include <SDL2/SDL_version.h>
+
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/surface.hpp>
+#include <sdlw/worker_pool.hpp>
+
+namespace sdl {
+
+// Destination area, in pixels, below which the worker_pool overloads of
+// fill, blit, convert_pixels and convert run serially: handing out bands
+// costs more than it saves on small surfaces.
+constexpr auto parallel_min_area = 512 * 512;
+
+namespace detail {
+
+// Rows per band: a band of the destination stays near 256 KiB so it fits
+// in a core's L2, and every thread gets at least one band.
+inline auto band_rows(int rows, int row_bytes, int threads) noexcept -> int
+{
+    const auto fit = std::max(256 * 1024 / std::max(row_bytes, 1), 1);
+    const auto share = (rows + threads - 1) / std::max(threads, 1);
+    return std::max(std::min(fit, share), 1);
+}
+
+// Calls run(band, y, h) for consecutive bands of rows rows each. The first
+// band runs alone on the calling thread, so bad arguments fail there with
+// SDL's own message and before any work is handed out.
+template<typename Run>
+auto for_each_band(worker_pool& pool, int rows, int band, Run&& run) -> status
+{
+    if (const auto first = run(0, 0, std::min(band, rows)); !first) {
+        return first;
+    }
+    const auto count = (rows + band - 1) / band;
+    auto failed = std::atomic<bool>{false};
+    pool.for_each(count - 1, [&](int i) {
+        const auto y = (i + 1) * band;
+        if (!run(i + 1, y, std::min(band, rows - y))) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    });
+    if (failed.load()) {
+        set_error("sdl: a band of a parallel surface operation failed");
+        return unexpected{error_code{}};
+    }
+    return {};
+}
+
+// SDL_UpperBlit's clipping: returns the source area and moves dstrect to
+// the destination area, which is empty when nothing is drawn.
+inline auto clip_blit(const SDL_Surface* src, const rect* srcrect, const SDL_Surface* dst, rect& dstrect) noexcept -> rect
+{
+    auto s = rect{0, 0, src->w, src->h};
+    if (srcrect) {
+        s = *srcrect;
+        if (s.x < 0) {
+            s.w += s.x;
+            dstrect.x -= s.x;
+            s.x = 0;
+        }
+        if (s.y < 0) {
+            s.h += s.y;
+            dstrect.y -= s.y;
+            s.y = 0;
+        }
+        s.w = std::min(s.w, src->w - s.x);
+        s.h = std::min(s.h, src->h - s.y);
+    }
+
+    const auto& clip = dst->clip_rect;
+    if (const auto d = clip.x - dstrect.x; d > 0) {
+        s.w -= d;
+        s.x += d;
+        dstrect.x += d;
+    }
+    if (const auto d = dstrect.x + s.w - clip.x - clip.w; d > 0) s.w -= d;
+    if (const auto d = clip.y - dstrect.y; d > 0) {
+        s.h -= d;
+        s.y += d;
+        dstrect.y += d;
+    }
+    if (const auto d = dstrect.y + s.h - clip.y - clip.h; d > 0) s.h -= d;
+
+    if (s.w <= 0 || s.h <= 0) {
+        s.w = s.h = 0;
+    }
+    dstrect.w = s.w;
+    dstrect.h = s.h;
+    return s;
+}
+
+// Rows [y, y + h) of s as a surface of their own, with the same palette and
+// blit settings. SDL keeps the state of a running blit in the source
+// surface, so concurrent blits each need their own.
+inline auto band_view(SDL_Surface* s, int y, int h) noexcept -> surface
+{
+    const auto pixels = static_cast<u8*>(s->pixels) + static_cast<std::ptrdiff_t>(y) * s->pitch;
+    auto view = surface{SDL_CreateRGBSurfaceWithFormatFrom(pixels, s->w, h, s->format->BitsPerPixel, s->pitch, s->format->format)};
+    const auto v = view.get_pointer();
+    if (!v) return view;
+
+    if (s->format->palette) SDL_SetSurfacePalette(v, s->format->palette);
+    auto mode = SDL_BlendMode{};
+    SDL_GetSurfaceBlendMode(s, &mode);
+    SDL_SetSurfaceBlendMode(v, mode);
+    auto a = u8{};
+    SDL_GetSurfaceAlphaMod(s, &a);
+    SDL_SetSurfaceAlphaMod(v, a);
+    auto r = u8{};
+    auto g = u8{};
+    auto b = u8{};
+    SDL_GetSurfaceColorMod(s, &r, &g, &b);
+    SDL_SetSurfaceColorMod(v, r, g, b);
+    if (auto key = u32{}; SDL_GetColorKey(s, &key) == 0) SDL_SetColorKey(v, SDL_TRUE, key);
+    return view;
+}
+
+// Surfaces that must go through SDL in one piece: RLE surfaces and locked
+// ones, which SDL rejects with an error.
+inline auto is_band_safe(const SDL_Surface* s) noexcept -> bool
+{
+    return !SDL_MUSTLOCK(s) && s->locked == 0;
+}
+
+inline auto parallel_blit(worker_pool& pool, const surface& src, const rect* srcrect, surface& dst, rect& dstrect) noexcept -> status
+{
+    const auto s = src.get_pointer();
+    const auto d = dst.get_pointer();
+    auto area = dstrect;
+    const auto from = clip_blit(s, srcrect, d, area);
+    if (area.w * area.h < parallel_min_area || pool.thread_count() == 1 || s == d || !is_band_safe(s) || !is_band_safe(d)) {
+        return make_status(SDL_BlitSurface(s, srcrect, d, &dstrect));
+    }
+
+    const auto band = band_rows(area.h, area.w * d->format->BytesPerPixel, pool.thread_count());
+    auto views = std::vector<surface>{};
+    views.reserve(static_cast<std::size_t>((area.h + band - 1) / band));
+    for (auto y = 0; y < area.h; y += band) {
+        views.push_back(band_view(s, from.y + y, std::min(band, area.h - y)));
+        if (!views.back().get_pointer()) return unexpected{error_code{}};
+        // An empty blit builds the view's blit map here rather than
+        // concurrently on the workers.
+        auto none = rect{};
+        if (SDL_LowerBlit(views.back().get_pointer(), &none, d, &none) < 0) return unexpected{error_code{}};
+    }
+
+    const auto result = for_each_band(pool, area.h, band, [&](int i, int y, int h) {
+        auto sr = rect{from.x, 0, area.w, h};
+        auto dr = rect{area.x, area.y + y, area.w, h};
+        return make_status(SDL_LowerBlit(views[static_cast<std::size_t>(i)].get_pointer(), &sr, d, &dr));
+    });
+    dstrect = area;
+    return result;
+}
+
+inline auto parallel_fill(worker_pool& pool, surface& dst, const rect& r, u32 color) noexcept -> status
+{
+    const auto d = dst.get_pointer();
+    auto area = rect{};
+    if (!SDL_IntersectRect(&r, &d->clip_rect, &area)) return {};
+    if (area.w * area.h < parallel_min_area || pool.thread_count() == 1 || !is_band_safe(d)) {
+        return make_status(SDL_FillRect(d, &r, color));
+    }
+
+    const auto band = band_rows(area.h, area.w * d->format->BytesPerPixel, pool.thread_count());
+    return for_each_band(pool, area.h, band, [&](int, int y, int h) {
+        const auto part = rect{area.x, area.y + y, area.w, h};
+        return make_status(SDL_FillRect(d, &part, color));
+    });
+}
+
+inline auto parallel_convert_pixels(
+    worker_pool& pool,
+    int width,
+    int height,
+    pixel_format_type src_format,
+    const void* src,
+    int src_pitch,
+    pixel_format_type dst_format,
+    void* dst,
+    int dst_pitch) noexcept -> status
+{
+    // Planar formats keep their chroma after the luma rows, so their rows
+    // cannot be split.
+    if (width * height < parallel_min_area || pool.thread_count() == 1 || is_fourcc(src_format) || is_fourcc(dst_format)) {
+        return convert_pixels(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch, std::nothrow);
+    }
+
+    const auto row_bytes = width * SDL_BYTESPERPIXEL(static_cast<u32>(dst_format));
+    const auto band = band_rows(height, row_bytes, pool.thread_count());
+    return for_each_band(pool, height, band, [&](int, int y, int h) {
+        const auto s = static_cast<const u8*>(src) + static_cast<std::ptrdiff_t>(y) * src_pitch;
+        const auto d = static_cast<u8*>(dst) + static_cast<std::ptrdiff_t>(y) * dst_pitch;
+        return convert_pixels(width, h, src_format, s, src_pitch, dst_format, d, dst_pitch, std::nothrow);
+    });
+}
+
+inline auto parallel_convert(worker_pool& pool, const surface& src, const pixel_format& fmt) noexcept -> expected<surface>
+{
+    const auto s = src.get_pointer();
+    const auto f = fmt.get_pointer();
+    // Color keys and palettes make SDL_ConvertSurface do more than convert
+    // pixels; RLE is only ever requested, not yet applied, before 2.0.14.
+    auto key = u32{};
+    auto serial = s->w * s->h < parallel_min_area || pool.thread_count() == 1 || !is_band_safe(s)
+        || s->format->palette || f->palette || SDL_GetColorKey(s, &key) == 0;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    serial = serial || SDL_HasSurfaceRLE(s);
+#endif
+    if (serial) {
+        if (const auto converted = SDL_ConvertSurface(s, f, 0)) return surface{converted};
+        return unexpected{error_code{}};
+    }
+
+    // The blend mode and modulation SDL gives the result depend only on the
+    // surface settings and formats, so they are taken from converting a
+    // single row.
+    const auto row = band_view(s, 0, 1);
+    if (!row.get_pointer()) return unexpected{error_code{}};
+    const auto probe = surface{SDL_ConvertSurface(row.get_pointer(), f, 0)};
+    if (!probe.get_pointer()) return unexpected{error_code{}};
+
+    auto result = surface{SDL_CreateRGBSurfaceWithFormat(0, s->w, s->h, f->BitsPerPixel, f->format)};
+    const auto r = result.get_pointer();
+    if (!r) return unexpected{error_code{}};
+    auto mode = SDL_BlendMode{};
+    SDL_GetSurfaceBlendMode(probe.get_pointer(), &mode);
+    SDL_SetSurfaceBlendMode(r, mode);
+    auto a = u8{};
+    SDL_GetSurfaceAlphaMod(probe.get_pointer(), &a);
+    SDL_SetSurfaceAlphaMod(r, a);
+    auto cr = u8{};
+    auto cg = u8{};
+    auto cb = u8{};
+    SDL_GetSurfaceColorMod(probe.get_pointer(), &cr, &cg, &cb);
+    SDL_SetSurfaceColorMod(r, cr, cg, cb);
+    // SDL_ConvertSurface also copies the clip rect, which the row view
+    // cannot carry.
+    SDL_SetClipRect(r, &s->clip_rect);
+
+    const auto from = static_cast<pixel_format_type>(s->format->format);
+    const auto to = static_cast<pixel_format_type>(f->format);
+    const auto result_status = parallel_convert_pixels(pool, s->w, s->h, from, s->pixels, s->pitch, to, r->pixels, r->pitch);
+    if (!result_status) return unexpected{result_status.error()};
+    return result;
+}
+
+} // namespace detail
+
+// The overloads below split the destination into horizontal bands and
+// process them on pool. The result is the same as the serial call, bit for
+// bit; small areas, RLE or locked surfaces and blits from a surface onto
+// itself take the serial path.
+
+inline void fill(worker_pool& pool, surface& dst, const rect& r, u32 color)
+{
+    if (!detail::parallel_fill(pool, dst, r, color)) {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto fill(worker_pool& pool, surface& dst, const rect& r, u32 color, std::nothrow_t) noexcept -> status
+{
+    return detail::parallel_fill(pool, dst, r, color);
+}
+
+inline void blit(worker_pool& pool, const surface& src, surface& dst, rect& dstrect)
+{
+    if (!detail::parallel_blit(pool, src, nullptr, dst, dstrect)) {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto blit(worker_pool& pool, const surface& src, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::parallel_blit(pool, src, nullptr, dst, dstrect);
+}
+
+inline void blit(worker_pool& pool, const surface& src, const rect& srcrect, surface& dst, rect& dstrect)
+{
+    if (!detail::parallel_blit(pool, src, &srcrect, dst, dstrect)) {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto blit(worker_pool& pool, const surface& src, const rect& srcrect, surface& dst, rect& dstrect, std::nothrow_t) noexcept
+    -> status
+{
+    return detail::parallel_blit(pool, src, &srcrect, dst, dstrect);
+}
+
+inline void convert_pixels(
+    worker_pool& pool,
+    int width,
+    int height,
+    pixel_format_type src_format,
+    const void* src,
+    int src_pitch,
+    pixel_format_type dst_format,
+    void* dst,
+    int dst_pitch)
+{
+    if (!detail::parallel_convert_pixels(pool, width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch)) {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto convert_pixels(
+    worker_pool& pool,
+    int width,
+    int height,
+    pixel_format_type src_format,
+    const void* src,
+    int src_pitch,
+    pixel_format_type dst_format,
+    void* dst,
+    int dst_pitch,
+    std::nothrow_t) noexcept -> status
+{
+    return detail::parallel_convert_pixels(pool, width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
+}
+
+// Same as src.convert(fmt).
+inline auto convert(worker_pool& pool, const surface& src, pixel_format_ref fmt) -> surface
+{
+    auto result = detail::parallel_convert(pool, src, fmt);
+    if (!result) SDLW_DETAIL_THROW_ERROR();
+    return std::move(*result);
+}
+
+inline auto convert(worker_pool& pool, const surface& src, pixel_format_ref fmt, std::nothrow_t) noexcept -> expected<surface>
+{
+    return detail::parallel_convert(pool, src, fmt);
+}
+
+} // namespace sdl
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <SDL2/SDL_render.h>
+
+#include <sdlw/blend_mode.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/render_state_cache.hpp>
+
+namespace sdl {
+
+// Draw list filled by a single worker thread. Each item carries its own
+// layer, color and blend mode, so items can be reordered freely before
+// submission. Recording never touches SDL.
+class command_recorder {
+public:
+    static constexpr auto white = color{255, 255, 255, 255};
+
+    void set_layer(int layer) noexcept
+    {
+        _layer = layer;
+    }
+
+    auto layer() const noexcept -> int
+    {
+        return _layer;
+    }
+
+    void reserve(std::size_t item_count)
+    {
+        _items.reserve(item_count);
+    }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return _items.size();
+    }
+
+    void reset() noexcept
+    {
+        _items.clear();
+        _layer = 0;
+        _sorted = true;
+    }
+
+    void draw_line(const point& p1, const point& p2, color c, blend_mode mode = blend_mode::blend)
+    {
+        // The second end point rides in the otherwise unused center field.
+        auto& i = push(kind::line, texture_ref{}, c, mode);
+        i.dst = rect{p1.x, p1.y, 0, 0};
+        i.center = p2;
+    }
+
+    void draw_point(const point& p, color c, blend_mode mode = blend_mode::blend)
+    {
+        push(kind::point, texture_ref{}, c, mode).dst = rect{p.x, p.y, 0, 0};
+    }
+
+    void draw_rectangle(const rect& r, color c, blend_mode mode = blend_mode::blend)
+    {
+        push(kind::outline, texture_ref{}, c, mode).dst = r;
+    }
+
+    void fill_rectangle(const rect& r, color c, blend_mode mode = blend_mode::blend)
+    {
+        push(kind::fill, texture_ref{}, c, mode).dst = r;
+    }
+
+    void copy(const texture_ref& t, const rect* src, const rect& dst, color mod = white, blend_mode mode = blend_mode::blend)
+    {
+        copy(t, src, dst, 0.0, nullptr, renderer_flip::none, mod, mode);
+    }
+
+    void copy(const sub_texture& st, const rect& dst, color mod = white, blend_mode mode = blend_mode::blend)
+    {
+        copy(*st.texture, &st.area, dst, mod, mode);
+    }
+
+    void copy(
+        const texture_ref& t,
+        const rect* src,
+        const rect& dst,
+        double angle,
+        const point* center,
+        renderer_flip flip,
+        color mod = white,
+        blend_mode mode = blend_mode::blend)
+    {
+        auto& i = push(kind::copy, t, mod, mode);
+        i.has_src = src != nullptr;
+        i.src = src ? *src : rect{};
+        i.dst = dst;
+        i.angle = angle;
+        i.has_center = center != nullptr;
+        i.center = center ? *center : point{};
+        i.flip = flip;
+    }
+
+    // Stable-sorts the recorded items by (layer, texture, blend mode). Call
+    // it on the worker once recording is done to keep the sort off the
+    // owning thread; submit() sorts any recorder that was not finished.
+    void finish()
+    {
+        if (!_sorted) {
+            std::stable_sort(_items.begin(), _items.end(), key_less);
+            _sorted = true;
+        }
+    }
+
+private:
+    friend class parallel_draw_list;
+
+    // clang-format off
+
+    enum class kind : u8 {
+        line,
+        point,
+        outline,
+        fill,
+        copy
+    };
+
+    // clang-format on
+
+    struct item {
+        int layer;
+        texture_ref texture;
+        blend_mode mode;
+        kind type;
+        bool has_src;
+        bool has_center;
+        renderer_flip flip;
+        color mod;
+        rect src;
+        rect dst;
+        double angle;
+        point center;
+    };
+
+    static auto key_less(const item& lhs, const item& rhs) noexcept -> bool
+    {
+        if (lhs.layer != rhs.layer) return lhs.layer < rhs.layer;
+        if (lhs.texture != rhs.texture) return lhs.texture.get_pointer() < rhs.texture.get_pointer();
+        return lhs.mode < rhs.mode;
+    }
+
+    auto push(kind type, const texture_ref& t, color c, blend_mode mode) -> item&
+    {
+        auto i = item{};
+        i.layer = _layer;
+        i.texture = t;
+        i.mode = mode;
+        i.type = type;
+        i.flip = renderer_flip::none;
+        i.mod = c;
+        if (_sorted && !_items.empty() && key_less(i, _items.back())) {
+            _sorted = false;
+        }
+        _items.push_back(i);
+        return _items.back();
+    }
+
+    std::vector<item> _items;
+    int _layer = 0;
+    bool _sorted = true;
+};
+
+// Owns one command_recorder per worker. Workers fill their own recorder
+// concurrently without locking; the owning thread then calls submit(),
+// which merges all recorders by (layer, texture, blend mode) and issues the
+// draws. Ties keep recording order, with lower recorder indices first, so
+// the output matches recording everything on recorder 0, then 1, and so on.
+class parallel_draw_list {
+public:
+    parallel_draw_list(renderer& r, std::size_t recorder_count)
+        : _renderer{r}
+        , _recorders(recorder_count)
+    {}
+
+    parallel_draw_list(const parallel_draw_list&) = delete;
+    auto operator=(const parallel_draw_list&) -> parallel_draw_list& = delete;
+
+    auto recorder_count() const noexcept -> std::size_t
+    {
+        return _recorders.size();
+    }
+
+    auto recorder(std::size_t index) noexcept -> command_recorder&
+    {
+        return _recorders[index];
+    }
+
+    // Number of SDL draw calls issued by the last submit().
+    auto draw_calls() const noexcept -> int
+    {
+        return _draw_calls;
+    }
+
+    // Must run on the renderer's thread after every worker is done.
+    void submit()
+    {
+        merge();
+        issue();
+        for (auto& r : _recorders) {
+            r.reset();
+        }
+    }
+
+private:
+    using item = command_recorder::item;
+    using kind = command_recorder::kind;
+
+    void merge()
+    {
+        _merged.clear();
+        _runs.clear();
+        _runs.push_back(0);
+        for (auto& r : _recorders) {
+            r.finish();
+            _merged.insert(_merged.end(), r._items.begin(), r._items.end());
+            _runs.push_back(_merged.size());
+        }
+        // Bottom-up merge of adjacent sorted runs; inplace_merge is stable
+        // and keeps the left run first, which preserves recorder order.
+        for (auto width = std::size_t{1}; width < _runs.size() - 1; width *= 2) {
+            for (auto i = std::size_t{0}; i + width < _runs.size() - 1; i += 2 * width) {
+                const auto first = _merged.begin() + _runs[i];
+                const auto middle = _merged.begin() + _runs[i + width];
+                const auto last = _merged.begin() + _runs[std::min(i + 2 * width, _runs.size() - 1)];
+                std::inplace_merge(first, middle, last, command_recorder::key_less);
+            }
+        }
+    }
+
+    void issue()
+    {
+        _draw_calls = 0;
+        auto state = render_state_cache{_renderer};
+        auto current = static_cast<const item*>(nullptr);
+        for (const auto& i : _merged) {
+            if (i.type == kind::copy) {
+                auto t = i.texture;
+                const auto new_texture = !current || current->texture != i.texture;
+                if (new_texture || current->mode != i.mode) {
+                    t.set_blend_mode(i.mode);
+                }
+                if (new_texture || current->mod != i.mod) {
+                    t.set_color_mod(i.mod.r, i.mod.g, i.mod.b);
+                    t.set_alpha_mod(i.mod.a);
+                }
+                const auto src = i.has_src ? &i.src : nullptr;
+                if (i.angle == 0.0 && i.flip == renderer_flip::none) {
+                    _renderer.copy(t, src, &i.dst);
+                } else {
+                    _renderer.copy(t, src, &i.dst, i.angle, i.has_center ? &i.center : nullptr, i.flip);
+                }
+                current = &i;
+            } else {
+                state.set_draw_color(i.mod);
+                state.set_draw_blend_mode(i.mode);
+                switch (i.type) {
+                case kind::line: _renderer.draw_line(point{i.dst.x, i.dst.y}, i.center); break;
+                case kind::point: _renderer.draw_point(point{i.dst.x, i.dst.y}); break;
+                case kind::outline: _renderer.draw_rectangle(i.dst); break;
+                default: _renderer.fill_rectangle(i.dst); break;
+                }
+            }
+            ++_draw_calls;
+        }
+    }
+
+    renderer& _renderer;
+    std::vector<command_recorder> _recorders;
+    std::vector<item> _merged;
+    std::vector<std::size_t> _runs;
+    int _draw_calls = 0;
+};
+
+} // namespace sdl
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <new>
+
+#include <sdlw/assert.hpp>
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/surface.hpp>
+
+namespace sdl {
+
+namespace detail {
+
+// Channel indices used below: r, g, b, a.
+constexpr auto no_channel = -1;
+
+// Bit widths of the four components of a packed layout, most significant
+// first. Three-component layouts have a zero-width padding component.
+constexpr auto packed_widths(pixel_layout l) noexcept -> std::array<int, 4>
+{
+    switch (l) {
+    case pixel_layout::_332: return {0, 3, 3, 2};
+    case pixel_layout::_4444: return {4, 4, 4, 4};
+    case pixel_layout::_1555: return {1, 5, 5, 5};
+    case pixel_layout::_5551: return {5, 5, 5, 1};
+    case pixel_layout::_565: return {0, 5, 6, 5};
+    case pixel_layout::_8888: return {8, 8, 8, 8};
+    case pixel_layout::_2101010: return {2, 10, 10, 10};
+    case pixel_layout::_1010102: return {10, 10, 10, 2};
+    default: return {0, 0, 0, 0};
+    }
+}
+
+// Channel of each component of a packed order, most significant first.
+constexpr auto packed_channels(pixel_order o) noexcept -> std::array<int, 4>
+{
+    constexpr auto x = no_channel;
+    switch (o) {
+    case pixel_order::packed_xrgb: return {x, 0, 1, 2};
+    case pixel_order::packed_rgbx: return {0, 1, 2, x};
+    case pixel_order::packed_argb: return {3, 0, 1, 2};
+    case pixel_order::packed_rgba: return {0, 1, 2, 3};
+    case pixel_order::packed_xbgr: return {x, 2, 1, 0};
+    case pixel_order::packed_bgrx: return {2, 1, 0, x};
+    case pixel_order::packed_abgr: return {3, 2, 1, 0};
+    case pixel_order::packed_bgra: return {2, 1, 0, 3};
+    default: return {x, x, x, x};
+    }
+}
+
+// Channel of each byte of an array order, in memory order.
+constexpr auto array_channels(pixel_order o) noexcept -> std::array<int, 4>
+{
+    constexpr auto x = no_channel;
+    switch (o) {
+    case pixel_order::array_rgb: return {0, 1, 2, x};
+    case pixel_order::array_bgr: return {2, 1, 0, x};
+    default: return {x, x, x, x};
+    }
+}
+
+constexpr auto is_packed_type(pixel_type t) noexcept -> bool
+{
+    return t == pixel_type::packed8 || t == pixel_type::packed16 || t == pixel_type::packed32;
+}
+
+template<int Bytes, bool Packed>
+struct pixel_storage {
+    using type = std::array<u8, Bytes>;
+};
+
+template<>
+struct pixel_storage<1, true> {
+    using type = u8;
+};
+
+template<>
+struct pixel_storage<2, true> {
+    using type = u16;
+};
+
+template<>
+struct pixel_storage<4, true> {
+    using type = u32;
+};
+
+} // namespace detail
+
+// Compile-time description of a packed or 8-bit array RGB format, derived
+// from the format's type, order and layout. Channel arrays are indexed r,
+// g, b, a; missing channels have zero width.
+template<pixel_format_type F>
+struct pixel_traits {
+    static constexpr auto format = F;
+    static constexpr auto is_packed = detail::is_packed_type(type(F));
+    static constexpr auto bytes = bytes_per_pixel(F);
+
+    static_assert(
+        (is_packed && layout(F) != pixel_layout::none) || (type(F) == pixel_type::arrayu8 && bytes == 3),
+        "pixel_traits: indexed, FOURCC and floating-point formats have no channel masks");
+
+    // Bit width and shift of each channel for packed formats, byte offset
+    // for arrays.
+    static constexpr auto width = [] {
+        auto w = std::array<int, 4>{};
+        const auto channels = is_packed ? detail::packed_channels(order(F)) : detail::array_channels(order(F));
+        const auto widths = is_packed ? detail::packed_widths(layout(F)) : std::array<int, 4>{8, 8, 8, 8};
+        for (auto i = 0; i < 4; ++i) {
+            if (channels[i] != detail::no_channel) w[channels[i]] = widths[i];
+        }
+        return w;
+    }();
+
+    static constexpr auto shift = [] {
+        auto s = std::array<int, 4>{};
+        const auto channels = is_packed ? detail::packed_channels(order(F)) : detail::array_channels(order(F));
+        const auto widths = is_packed ? detail::packed_widths(layout(F)) : std::array<int, 4>{8, 8, 8, 8};
+        auto bit = 0;
+        for (auto i = 3; i >= 0; --i) {
+            if (channels[i] != detail::no_channel) s[channels[i]] = is_packed ? bit : i;
+            bit += widths[i];
+        }
+        return s;
+    }();
+
+    static constexpr auto mask = [] {
+        auto m = std::array<u32, 4>{};
+        for (auto c = 0; c < 4; ++c) {
+            if (is_packed && width[c] > 0) m[c] = ((u32{1} << width[c]) - 1) << shift[c];
+        }
+        return m;
+    }();
+
+    static constexpr auto has_alpha = width[3] > 0;
+
+    // Raw pixel: u8, u16 or u32 for packed formats, read in native byte
+    // order; three bytes in memory order for arrays.
+    using value_type = typename detail::pixel_storage<bytes, is_packed>::type;
+
+    // Channels are widened the way SDL_GetRGBA does: narrow ones to
+    // floor(v * 255 / max), and a missing alpha reads as opaque.
+    static constexpr auto unpack(value_type p) noexcept -> color
+    {
+        auto c = std::array<u8, 4>{0, 0, 0, 255};
+        for (auto i = 0; i < 4; ++i) {
+            if (width[i] == 0) continue;
+            if constexpr (is_packed) {
+                const auto max = (u32{1} << width[i]) - 1;
+                const auto v = (static_cast<u32>(p) >> shift[i]) & max;
+                c[i] = static_cast<u8>(width[i] > 8 ? v >> (width[i] - 8) : v * 255 / max);
+            } else {
+                c[i] = p[static_cast<std::size_t>(shift[i])];
+            }
+        }
+        return color{c[0], c[1], c[2], c[3]};
+    }
+
+    // Channels are narrowed by truncation, as in SDL_MapRGBA; wider ones
+    // repeat their high bits. Padding bits are zero.
+    static constexpr auto pack(color col) noexcept -> value_type
+    {
+        const u8 c[] = {col.r, col.g, col.b, col.a};
+        if constexpr (is_packed) {
+            auto p = u32{0};
+            for (auto i = 0; i < 4; ++i) {
+                if (width[i] == 0) continue;
+                const auto v = static_cast<u32>(c[i]);
+                const auto bits = width[i] > 8 ? v << (width[i] - 8) | v >> (16 - width[i]) : v >> (8 - width[i]);
+                p |= bits << shift[i];
+            }
+            return static_cast<value_type>(p);
+        } else {
+            auto p = value_type{};
+            for (auto i = 0; i < 3; ++i) {
+                p[static_cast<std::size_t>(shift[i])] = c[i];
+            }
+            return p;
+        }
+    }
+};
+
+// Typed access to the pixels of a surface or a locked texture whose format
+// is known at compile time. Rows are pitch() bytes apart; the view does
+// not own or lock anything.
+template<pixel_format_type F>
+class pixel_view {
+public:
+    using traits = pixel_traits<F>;
+    using value_type = typename traits::value_type;
+
+    // Iterates rows as spans, stepping pitch bytes at a time.
+    class row_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = span<typename traits::value_type>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        row_iterator() noexcept = default;
+
+        auto operator*() const noexcept -> value_type
+        {
+            return value_type(reinterpret_cast<typename traits::value_type*>(_row), _width);
+        }
+
+        auto operator++() noexcept -> row_iterator&
+        {
+            _row += _pitch;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> row_iterator
+        {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        auto operator==(const row_iterator& other) const noexcept -> bool
+        {
+            return _row == other._row;
+        }
+
+        auto operator!=(const row_iterator& other) const noexcept -> bool
+        {
+            return !(*this == other);
+        }
+
+    private:
+        friend class pixel_view;
+
+        row_iterator(u8* row, int pitch, int width) noexcept
+            : _row{row}
+            , _pitch{pitch}
+            , _width{width}
+        {}
+
+        u8* _row = nullptr;
+        int _pitch = 0;
+        int _width = 0;
+    };
+
+    struct row_range {
+        row_iterator first;
+        row_iterator last;
+
+        auto begin() const noexcept -> row_iterator
+        {
+            return first;
+        }
+
+        auto end() const noexcept -> row_iterator
+        {
+            return last;
+        }
+    };
+
+    pixel_view(void* pixels, int pitch, const sdl::size& size) noexcept
+        : _pixels{static_cast<u8*>(pixels)}
+        , _pitch{pitch}
+        , _size{size}
+    {}
+
+    // The surface must have format F and, if it is RLE encoded, be locked.
+    explicit pixel_view(const surface& s) noexcept
+        : pixel_view{s.pixels(), s.pitch(), s.size()}
+    {
+        SDL_ASSERT(s.format().format() == F);
+        SDL_ASSERT(!s.must_lock() || s.get_pointer()->locked);
+    }
+
+    static constexpr auto format() noexcept -> pixel_format_type
+    {
+        return F;
+    }
+
+    static constexpr auto unpack(value_type p) noexcept -> color
+    {
+        return traits::unpack(p);
+    }
+
+    static constexpr auto pack(color c) noexcept -> value_type
+    {
+        return traits::pack(c);
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _size;
+    }
+
+    auto pitch() const noexcept -> int
+    {
+        return _pitch;
+    }
+
+    auto row(int y) const noexcept -> span<value_type>
+    {
+        return span<value_type>(reinterpret_cast<value_type*>(_pixels + static_cast<std::ptrdiff_t>(y) * _pitch), _size.w);
+    }
+
+    auto rows() const noexcept -> row_range
+    {
+        const auto end = _pixels + static_cast<std::ptrdiff_t>(_size.h) * _pitch;
+        return {row_iterator{_pixels, _pitch, _size.w}, row_iterator{end, _pitch, _size.w}};
+    }
+
+    auto operator()(int x, int y) const noexcept -> value_type&
+    {
+        return row(y)[x];
+    }
+
+    auto get(int x, int y) const noexcept -> color
+    {
+        return unpack((*this)(x, y));
+    }
+
+    void set(int x, int y, color c) const noexcept
+    {
+        (*this)(x, y) = pack(c);
+    }
+
+private:
+    u8* _pixels;
+    int _pitch;
+    sdl::size _size;
+};
+
+namespace detail {
+
+// Returns false for formats without a pixel_view.
+template<typename Visitor>
+auto visit_format(pixel_format_type format, void* pixels, int pitch, const sdl::size& size, Visitor& visitor) -> bool
+{
+    switch (format) {
+#define SDLW_DETAIL_VISIT(f)                                           \
+    case pixel_format_type::f:                                         \
+        visitor(pixel_view<pixel_format_type::f>{pixels, pitch, size}); \
+        return true;
+        SDLW_DETAIL_VISIT(rgb332)
+        SDLW_DETAIL_VISIT(rgb444)
+        SDLW_DETAIL_VISIT(rgb555)
+        SDLW_DETAIL_VISIT(bgr555)
+        SDLW_DETAIL_VISIT(argb4444)
+        SDLW_DETAIL_VISIT(rgba4444)
+        SDLW_DETAIL_VISIT(abgr4444)
+        SDLW_DETAIL_VISIT(bgra4444)
+        SDLW_DETAIL_VISIT(argb1555)
+        SDLW_DETAIL_VISIT(rgba5551)
+        SDLW_DETAIL_VISIT(abgr1555)
+        SDLW_DETAIL_VISIT(bgra5551)
+        SDLW_DETAIL_VISIT(rgb565)
+        SDLW_DETAIL_VISIT(bgr565)
+        SDLW_DETAIL_VISIT(rgb24)
+        SDLW_DETAIL_VISIT(bgr24)
+        SDLW_DETAIL_VISIT(rgb888)
+        SDLW_DETAIL_VISIT(rgbx8888)
+        SDLW_DETAIL_VISIT(bgr888)
+        SDLW_DETAIL_VISIT(bgrx8888)
+        SDLW_DETAIL_VISIT(argb8888)
+        SDLW_DETAIL_VISIT(rgba8888)
+        SDLW_DETAIL_VISIT(abgr8888)
+        SDLW_DETAIL_VISIT(bgra8888)
+        SDLW_DETAIL_VISIT(argb2101010)
+#undef SDLW_DETAIL_VISIT
+    default: return false;
+    }
+}
+
+} // namespace detail
+
+// Calls visitor(pixel_view<F>) once with F the format of the pixels, so a
+// generic kernel is specialized per format instead of branching per pixel.
+// Indexed, FOURCC and floating-point formats are errors.
+template<typename Visitor>
+void visit_format(pixel_format_type format, void* pixels, int pitch, const sdl::size& size, Visitor&& visitor)
+{
+    if (!detail::visit_format(format, pixels, pitch, size, visitor)) {
+        set_error("sdl::visit_format: unsupported pixel format %s", SDL_GetPixelFormatName(static_cast<u32>(format)));
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+template<typename Visitor>
+auto visit_format(pixel_format_type format, void* pixels, int pitch, const sdl::size& size, Visitor&& visitor, std::nothrow_t)
+    -> status
+{
+    if (!detail::visit_format(format, pixels, pitch, size, visitor)) {
+        set_error("sdl::visit_format: unsupported pixel format %s", SDL_GetPixelFormatName(static_cast<u32>(format)));
+        return unexpected{error_code{}};
+    }
+    return {};
+}
+
+// The surface must not be RLE encoded unless it is locked.
+template<typename Visitor>
+void visit_format(const surface& s, Visitor&& visitor)
+{
+    SDL_ASSERT(!s.must_lock() || s.get_pointer()->locked);
+    visit_format(s.format().format(), s.pixels(), s.pitch(), s.size(), visitor);
+}
+
+template<typename Visitor>
+auto visit_format(const surface& s, Visitor&& visitor, std::nothrow_t) -> status
+{
+    SDL_ASSERT(!s.must_lock() || s.get_pointer()->locked);
+    return visit_format(s.format().format(), s.pixels(), s.pitch(), s.size(), visitor, std::nothrow);
+}
+
+} // namespace sdl
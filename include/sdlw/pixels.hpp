@@ -1,13 +1,31 @@
 #pragma once
 
+#include <array>
+#include <memory>
+
 #include <SDL2/SDL_pixels.h>
 
+#include <sdlw/error.hpp>
 #include <sdlw/types.hpp>
 
+#include "sdlw/detail/utility.hpp"
+
 namespace sdl {
 
 using color = SDL_Color;
 
+// SDL_Color lives in the global namespace, so these are found by ordinary
+// lookup inside namespace sdl rather than by ADL.
+constexpr auto operator==(const color& lhs, const color& rhs) noexcept -> bool
+{
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
+}
+
+constexpr auto operator!=(const color& lhs, const color& rhs) noexcept -> bool
+{
+    return !(lhs == rhs);
+}
+
 // clang-format off
 
 enum class alpha : u8 {
@@ -163,7 +181,7 @@ public:
     explicit palette(int num_colors)
         : _palette{SDL_AllocPalette(num_colors)}
     {
-        if (!_palette) throw error{};
+        if (!_palette) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto colors() const noexcept -> span<color>
@@ -191,7 +209,7 @@ public:
     explicit pixel_format(pixel_format_type fmt)
         : _pixel_format{SDL_AllocFormat(static_cast<u32>(fmt))}
     {
-        if (!_pixel_format) throw error{};
+        if (!_pixel_format) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto format() const noexcept -> pixel_format_type
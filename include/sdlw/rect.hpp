@@ -1,12 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <optional>
 #include <tuple>
+#include <vector>
 
 #include <SDL2/SDL_rect.h>
+#include <SDL2/SDL_version.h>
 
 #include <sdlw/types.hpp>
 
+#if SDL_VERSION_ATLEAST(2, 0, 10)
+#    define SDLW_DETAIL_HAS_FLOAT_RECT 1
+#else
+#    define SDLW_DETAIL_HAS_FLOAT_RECT 0
+#endif
+
 namespace sdl {
 
 // clang-format off
@@ -236,4 +246,419 @@ inline auto rectangle_union(const rect& r1, const rect& r2) noexcept -> rect
     return result;
 }
 
+#if SDLW_DETAIL_HAS_FLOAT_RECT
+
+namespace detail {
+
+template<typename... Ts>
+inline constexpr auto all_integral_v = (std::is_integral_v<Ts> && ...);
+
+} // namespace detail
+
+// clang-format off
+
+struct fpoint : SDL_FPoint {
+    fpoint() = default;
+
+    constexpr fpoint(const SDL_FPoint& p) noexcept
+        : SDL_FPoint{p}
+    {}
+
+    // All-integer arguments need explicit construction, so braced calls
+    // such as draw_point({1, 2}) keep resolving to the point overloads.
+    template<typename X, typename Y, std::enable_if_t<detail::all_integral_v<X, Y>, int> = 0>
+    constexpr explicit fpoint(X x, Y y) noexcept
+        : SDL_FPoint{static_cast<float>(x), static_cast<float>(y)}
+    {}
+
+    template<typename X, typename Y, std::enable_if_t<!detail::all_integral_v<X, Y>, int> = 0>
+    constexpr fpoint(X x, Y y) noexcept
+        : SDL_FPoint{static_cast<float>(x), static_cast<float>(y)}
+    {}
+
+    constexpr explicit fpoint(const point& p) noexcept
+        : SDL_FPoint{static_cast<float>(p.x), static_cast<float>(p.y)}
+    {}
+};
+
+// Comparison
+
+constexpr auto operator== (const fpoint& lhs, const fpoint& rhs) noexcept -> bool { return lhs.x == rhs.x && lhs.y == rhs.y; }
+constexpr auto operator!= (const fpoint& lhs, const fpoint& rhs) noexcept -> bool { return !(lhs == rhs);                    }
+constexpr auto operator<  (const fpoint& lhs, const fpoint& rhs) noexcept -> bool { return lhs.x < rhs.x && lhs.y < rhs.y;   }
+constexpr auto operator>  (const fpoint& lhs, const fpoint& rhs) noexcept -> bool { return rhs < lhs;                        }
+constexpr auto operator<= (const fpoint& lhs, const fpoint& rhs) noexcept -> bool { return !(rhs < lhs);                     }
+constexpr auto operator>= (const fpoint& lhs, const fpoint& rhs) noexcept -> bool { return !(lhs < rhs);                     }
+
+// Arithmetic (unary)
+
+constexpr auto operator-(const fpoint& p) noexcept -> fpoint { return {-p.x, -p.y}; }
+
+// Arithmetic (binary, symmetrical)
+
+constexpr auto operator+(const fpoint& lhs, const fpoint& rhs) noexcept -> fpoint { return fpoint{lhs.x + rhs.x, lhs.y + rhs.y}; }
+constexpr auto operator-(const fpoint& lhs, const fpoint& rhs) noexcept -> fpoint { return fpoint{lhs.x - rhs.x, lhs.y - rhs.y}; }
+constexpr auto operator*(const fpoint& lhs, const fpoint& rhs) noexcept -> fpoint { return fpoint{lhs.x * rhs.x, lhs.y * rhs.y}; }
+constexpr auto operator/(const fpoint& lhs, const fpoint& rhs) noexcept -> fpoint { return fpoint{lhs.x / rhs.x, lhs.y / rhs.y}; }
+
+// Arithmetic (assignment, symmetrical)
+
+constexpr auto operator+=(fpoint& lhs, const fpoint& rhs) noexcept -> fpoint& { return lhs = lhs + rhs; }
+constexpr auto operator-=(fpoint& lhs, const fpoint& rhs) noexcept -> fpoint& { return lhs = lhs - rhs; }
+constexpr auto operator*=(fpoint& lhs, const fpoint& rhs) noexcept -> fpoint& { return lhs = lhs * rhs; }
+constexpr auto operator/=(fpoint& lhs, const fpoint& rhs) noexcept -> fpoint& { return lhs = lhs / rhs; }
+
+// Arithmetic (binary, asymmetrical)
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator+(const fpoint& lhs, T rhs) noexcept -> fpoint { return {lhs.x + static_cast<float>(rhs), lhs.y + static_cast<float>(rhs)}; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator+(T lhs, const fpoint& rhs) noexcept -> fpoint { return rhs + lhs; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator-(const fpoint& lhs, T rhs) noexcept -> fpoint { return {lhs.x - static_cast<float>(rhs), lhs.y - static_cast<float>(rhs)}; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator*(const fpoint& lhs, T rhs) noexcept -> fpoint { return {lhs.x * static_cast<float>(rhs), lhs.y * static_cast<float>(rhs)}; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator*(T lhs, const fpoint& rhs) noexcept -> fpoint { return rhs * lhs; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator/(const fpoint& lhs, T rhs) noexcept -> fpoint { return {lhs.x / static_cast<float>(rhs), lhs.y / static_cast<float>(rhs)}; }
+
+// Arithmetic (assignment, asymmetrical)
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator+=(fpoint& lhs, T rhs) noexcept -> fpoint& { return lhs = lhs + rhs; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator-=(fpoint& lhs, T rhs) noexcept -> fpoint& { return lhs = lhs - rhs; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator*=(fpoint& lhs, T rhs) noexcept -> fpoint& { return lhs = lhs * rhs; }
+
+template<typename T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+constexpr auto operator/=(fpoint& lhs, T rhs) noexcept -> fpoint& { return lhs = lhs / rhs; }
+
+struct frect : SDL_FRect {
+    frect() = default;
+
+    constexpr frect(const SDL_FRect& r) noexcept
+        : SDL_FRect{r}
+    {}
+
+    template<typename X, typename Y, typename W, typename H, std::enable_if_t<detail::all_integral_v<X, Y, W, H>, int> = 0>
+    constexpr explicit frect(X x, Y y, W w, H h) noexcept
+        : SDL_FRect{static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)}
+    {}
+
+    template<typename X, typename Y, typename W, typename H, std::enable_if_t<!detail::all_integral_v<X, Y, W, H>, int> = 0>
+    constexpr frect(X x, Y y, W w, H h) noexcept
+        : SDL_FRect{static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)}
+    {}
+
+    constexpr explicit frect(const rect& r) noexcept
+        : SDL_FRect{static_cast<float>(r.x), static_cast<float>(r.y), static_cast<float>(r.w), static_cast<float>(r.h)}
+    {}
+};
+
+constexpr auto operator==(const frect& lhs, const frect& rhs) noexcept -> bool {
+    return lhs.x == rhs.x
+        && lhs.y == rhs.y
+        && lhs.w == rhs.w
+        && lhs.h == rhs.h;
+}
+
+constexpr auto operator!=(const frect& lhs, const frect& rhs) noexcept -> bool {
+    return !(lhs == rhs);
+}
+
+// clang-format on
+
+constexpr auto position_of(const frect& rect) noexcept -> fpoint
+{
+    return {rect.x, rect.y};
+}
+
+// The SDL_FRect helpers only arrived in SDL 2.0.22, so these are computed
+// here with the same half-open semantics as their integer counterparts.
+
+constexpr auto is_empty(const frect& rect) noexcept -> bool
+{
+    return rect.w <= 0.0f || rect.h <= 0.0f;
+}
+
+constexpr auto are_intersecting(const frect& r1, const frect& r2) noexcept -> bool
+{
+    return !is_empty(r1) && !is_empty(r2) && r1.x < r2.x + r2.w && r2.x < r1.x + r1.w && r1.y < r2.y + r2.h
+        && r2.y < r1.y + r1.h;
+}
+
+constexpr auto intersection(const frect& r1, const frect& r2) noexcept -> std::optional<frect>
+{
+    if (!are_intersecting(r1, r2)) {
+        return std::nullopt;
+    }
+    const auto x1 = std::max(r1.x, r2.x);
+    const auto y1 = std::max(r1.y, r2.y);
+    const auto x2 = std::min(r1.x + r1.w, r2.x + r2.w);
+    const auto y2 = std::min(r1.y + r1.h, r2.y + r2.h);
+    return frect{x1, y1, x2 - x1, y2 - y1};
+}
+
+constexpr auto is_point_in_rectangle(const fpoint& p, const frect& rect) noexcept -> bool
+{
+    return p.x >= rect.x && p.x < rect.x + rect.w && p.y >= rect.y && p.y < rect.y + rect.h;
+}
+
+constexpr auto rectangle_union(const frect& r1, const frect& r2) noexcept -> frect
+{
+    if (is_empty(r1)) return r2;
+    if (is_empty(r2)) return r1;
+    const auto x1 = std::min(r1.x, r2.x);
+    const auto y1 = std::min(r1.y, r2.y);
+    const auto x2 = std::max(r1.x + r1.w, r2.x + r2.w);
+    const auto y2 = std::max(r1.y + r1.h, r2.y + r2.h);
+    return frect{x1, y1, x2 - x1, y2 - y1};
+}
+
+#endif
+
+namespace detail {
+
+constexpr auto overlap(const rect& a, const rect& b) noexcept -> rect
+{
+    const auto x1 = std::max(a.x, b.x);
+    const auto y1 = std::max(a.y, b.y);
+    const auto x2 = std::min(a.x + a.w, b.x + b.w);
+    const auto y2 = std::min(a.y + a.h, b.y + b.h);
+    return {x1, y1, std::max(x2 - x1, 0), std::max(y2 - y1, 0)};
+}
+
+constexpr auto bounding(const rect& a, const rect& b) noexcept -> rect
+{
+    const auto x1 = std::min(a.x, b.x);
+    const auto y1 = std::min(a.y, b.y);
+    const auto x2 = std::max(a.x + a.w, b.x + b.w);
+    const auto y2 = std::max(a.y + a.h, b.y + b.h);
+    return {x1, y1, x2 - x1, y2 - y1};
+}
+
+constexpr auto area_of(const rect& r) noexcept -> long long
+{
+    return static_cast<long long>(r.w) * r.h;
+}
+
+constexpr auto contains(const rect& outer, const rect& inner) noexcept -> bool
+{
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.w <= outer.x + outer.w
+        && inner.y + inner.h <= outer.y + outer.h;
+}
+
+// Appends the up to four pieces of a that lie outside b.
+inline void subtract(const rect& a, const rect& b, std::vector<rect>& out)
+{
+    const auto o = overlap(a, b);
+    if (o.w <= 0 || o.h <= 0) {
+        out.push_back(a);
+        return;
+    }
+    if (o.y > a.y) out.push_back(rect{a.x, a.y, a.w, o.y - a.y});
+    if (o.x > a.x) out.push_back(rect{a.x, o.y, o.x - a.x, o.h});
+    if (o.x + o.w < a.x + a.w) out.push_back(rect{o.x + o.w, o.y, a.x + a.w - o.x - o.w, o.h});
+    if (o.y + o.h < a.y + a.h) out.push_back(rect{a.x, o.y + o.h, a.w, a.y + a.h - o.y - o.h});
+}
+
+} // namespace detail
+
+// A set of pixels stored as non-overlapping rectangles. unite(), subtract()
+// and intersect() are exact; simplify() trades exactness for fewer
+// rectangles and only ever grows the covered area.
+class region {
+public:
+    region() = default;
+
+    explicit region(const rect& r)
+    {
+        unite(r);
+    }
+
+    auto rects() const noexcept -> span<const rect>
+    {
+        return _rects;
+    }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return _rects.size();
+    }
+
+    auto empty() const noexcept -> bool
+    {
+        return _rects.empty();
+    }
+
+    auto area() const noexcept -> long long
+    {
+        auto total = 0LL;
+        for (const auto& r : _rects) total += detail::area_of(r);
+        return total;
+    }
+
+    auto bounds() const noexcept -> rect
+    {
+        if (_rects.empty()) {
+            return {0, 0, 0, 0};
+        }
+        auto b = _rects.front();
+        for (const auto& r : _rects) b = detail::bounding(b, r);
+        return b;
+    }
+
+    auto contains(const point& p) const noexcept -> bool
+    {
+        return std::any_of(_rects.begin(), _rects.end(), [&p](const rect& r) {
+            return p.x >= r.x && p.y >= r.y && p.x < r.x + r.w && p.y < r.y + r.h;
+        });
+    }
+
+    void clear() noexcept
+    {
+        _rects.clear();
+    }
+
+    void unite(const rect& r)
+    {
+        if (r.w <= 0 || r.h <= 0) {
+            return;
+        }
+        _pieces.clear();
+        _pieces.push_back(r);
+        for (const auto& existing : _rects) {
+            _scratch.clear();
+            for (const auto& piece : _pieces) detail::subtract(piece, existing, _scratch);
+            _pieces.swap(_scratch);
+            if (_pieces.empty()) {
+                return;
+            }
+        }
+        _rects.insert(_rects.end(), _pieces.begin(), _pieces.end());
+        coalesce();
+    }
+
+    void unite(const region& other)
+    {
+        for (const auto& r : other._rects) unite(r);
+    }
+
+    void subtract(const rect& r)
+    {
+        if (r.w <= 0 || r.h <= 0) {
+            return;
+        }
+        _scratch.clear();
+        for (const auto& existing : _rects) detail::subtract(existing, r, _scratch);
+        _rects.swap(_scratch);
+        coalesce();
+    }
+
+    void subtract(const region& other)
+    {
+        for (const auto& r : other._rects) subtract(r);
+    }
+
+    void intersect(const rect& r)
+    {
+        auto out = std::size_t{0};
+        for (const auto& existing : _rects) {
+            const auto o = detail::overlap(existing, r);
+            if (o.w > 0 && o.h > 0) _rects[out++] = o;
+        }
+        _rects.resize(out);
+    }
+
+    void intersect(const region& other)
+    {
+        _scratch.clear();
+        for (const auto& a : _rects) {
+            for (const auto& b : other._rects) {
+                const auto o = detail::overlap(a, b);
+                if (o.w > 0 && o.h > 0) _scratch.push_back(o);
+            }
+        }
+        _rects.swap(_scratch);
+        coalesce();
+    }
+
+    // Merges rectangles until at most max_rects remain, each time picking
+    // the pair whose bounding box adds the fewest uncovered pixels.
+    void simplify(std::size_t max_rects)
+    {
+        max_rects = std::max<std::size_t>(max_rects, 1);
+        while (_rects.size() > max_rects) {
+            auto best_i = std::size_t{0};
+            auto best_j = std::size_t{1};
+            auto best_waste = std::numeric_limits<long long>::max();
+            for (auto i = std::size_t{0}; i != _rects.size(); ++i) {
+                for (auto j = i + 1; j != _rects.size(); ++j) {
+                    const auto waste = detail::area_of(detail::bounding(_rects[i], _rects[j])) - detail::area_of(_rects[i])
+                        - detail::area_of(_rects[j]);
+                    if (waste < best_waste) {
+                        best_waste = waste;
+                        best_i = i;
+                        best_j = j;
+                    }
+                }
+            }
+            // Grow the box over anything it touches so the set stays
+            // disjoint and every round removes at least one rectangle.
+            auto merged = detail::bounding(_rects[best_i], _rects[best_j]);
+            for (auto grown = true; grown;) {
+                grown = false;
+                for (const auto& r : _rects) {
+                    const auto o = detail::overlap(merged, r);
+                    if (o.w > 0 && o.h > 0 && !detail::contains(merged, r)) {
+                        merged = detail::bounding(merged, r);
+                        grown = true;
+                    }
+                }
+            }
+            _rects.erase(
+                std::remove_if(_rects.begin(), _rects.end(), [&merged](const rect& r) { return detail::contains(merged, r); }),
+                _rects.end());
+            _rects.push_back(merged);
+            coalesce();
+        }
+    }
+
+private:
+    // Losslessly joins rectangles that share a whole edge.
+    void coalesce()
+    {
+        for (auto merged = true; merged;) {
+            merged = false;
+            for (auto i = std::size_t{0}; i < _rects.size(); ++i) {
+                for (auto j = i + 1; j < _rects.size(); ++j) {
+                    auto& a = _rects[i];
+                    const auto& b = _rects[j];
+                    const auto vertical = a.x == b.x && a.w == b.w && (a.y + a.h == b.y || b.y + b.h == a.y);
+                    const auto horizontal = a.y == b.y && a.h == b.h && (a.x + a.w == b.x || b.x + b.w == a.x);
+                    if (vertical || horizontal) {
+                        a = detail::bounding(a, b);
+                        _rects.erase(_rects.begin() + j);
+                        merged = true;
+                        --j;
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<rect> _rects;
+    std::vector<rect> _pieces;
+    std::vector<rect> _scratch;
+};
+
 } // namespace sdl
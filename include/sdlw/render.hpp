@@ -1,10 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include <SDL2/SDL_render.h>
 
 #include <sdlw/blend_mode.hpp>
+#include <sdlw/error.hpp>
 #include <sdlw/pixels.hpp>
 #include <sdlw/rect.hpp>
 #include <sdlw/surface.hpp>
@@ -17,6 +21,7 @@ namespace sdl {
 class renderer_info;
 class texture;
 class texture_ref;
+struct sub_texture;
 
 // clang-format off
 
@@ -46,13 +51,13 @@ public:
     renderer(window& win, renderer::flags flags, int rendering_driver_index = -1)
         : renderer{SDL_CreateRenderer(win.get_pointer(), rendering_driver_index, static_cast<u32>(flags))}
     {
-        if (!_renderer) throw error{};
+        if (!_renderer) SDLW_DETAIL_THROW_ERROR();
     }
 
     explicit renderer(surface& s)
         : renderer{SDL_CreateSoftwareRenderer(s.get_pointer())}
     {
-        if (!_renderer) throw error{};
+        if (!_renderer) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto draw_blend_mode() const -> blend_mode
@@ -61,7 +66,7 @@ public:
         if (SDL_GetRenderDrawBlendMode(get_pointer(), &mode) == 0) {
             return static_cast<blend_mode>(mode);
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -69,35 +74,48 @@ public:
     {
         const auto sdl_blend_mode = static_cast<SDL_BlendMode>(mode);
         if (SDL_SetRenderDrawBlendMode(get_pointer(), sdl_blend_mode) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_draw_blend_mode(blend_mode mode, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetRenderDrawBlendMode(get_pointer(), static_cast<SDL_BlendMode>(mode)));
+    }
+
     auto draw_color() const -> color
     {
         auto c = color{};
         if (SDL_GetRenderDrawColor(get_pointer(), &c.r, &c.g, &c.b, &c.a) == 0) {
             return c;
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
     void set_draw_color(color c)
     {
         if (SDL_SetRenderDrawColor(get_pointer(), c.r, c.g, c.b, c.a) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_draw_color(color c, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetRenderDrawColor(get_pointer(), c.r, c.g, c.b, c.a));
+    }
+
     auto are_targets_supported() const noexcept -> bool
     {
         return SDL_RenderTargetSupported(get_pointer());
     }
 
-    auto target() -> texture_ref;
+    // An empty texture_ref stands for the default target.
+    auto target() const noexcept -> texture_ref;
 
-    void set_target(texture&);
+    void set_target(const texture_ref&);
+
+    auto set_target(const texture_ref&, std::nothrow_t) noexcept -> status;
 
     auto output_size() const -> size
     {
@@ -105,7 +123,7 @@ public:
         if (SDL_GetRendererOutputSize(get_pointer(), &sz.w, &sz.h) == 0) {
             return sz;
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -124,10 +142,15 @@ public:
     void set_clip(const rect& rect)
     {
         if (SDL_RenderSetClipRect(get_pointer(), &rect) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_clip(const rect& rect, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderSetClipRect(get_pointer(), &rect));
+    }
+
     auto viewport() const noexcept -> rect
     {
         auto r = rect{};
@@ -138,10 +161,15 @@ public:
     void set_viewport(const rect& viewport)
     {
         if (SDL_RenderSetViewport(get_pointer(), &viewport) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_viewport(const rect& viewport, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderSetViewport(get_pointer(), &viewport));
+    }
+
     auto scale() const noexcept -> std::pair<float, float>
     {
         auto xscale = float{};
@@ -153,10 +181,15 @@ public:
     void set_scale(float xscale, float yscale)
     {
         if (SDL_RenderSetScale(get_pointer(), xscale, yscale) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_scale(float xscale, float yscale, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderSetScale(get_pointer(), xscale, yscale));
+    }
+
     auto integer_scale() const noexcept -> bool
     {
         return SDL_RenderGetIntegerScale(get_pointer());
@@ -166,7 +199,7 @@ public:
     {
         const auto b = static_cast<SDL_bool>(should_enable);
         if (SDL_RenderSetIntegerScale(get_pointer(), b) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -180,7 +213,7 @@ public:
     void set_logical_size(const size& sz)
     {
         if (SDL_RenderSetLogicalSize(get_pointer(), sz.w, sz.h) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -191,24 +224,40 @@ public:
         const auto prend = get_pointer();
         const auto fmt = static_cast<u32>(format);
         if (SDL_RenderReadPixels(prend, &rect, fmt, pixels, pitch) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto read_pixels(void* pixels, const rect& rect, pixel_format_type format, int pitch, std::nothrow_t) const noexcept -> status
+    {
+        const auto fmt = static_cast<u32>(format);
+        return detail::make_status(SDL_RenderReadPixels(get_pointer(), &rect, fmt, pixels, pitch));
+    }
+
     void clear()
     {
         if (SDL_RenderClear(get_pointer()) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto clear(std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderClear(get_pointer()));
+    }
+
     void draw_line(const point& p1, const point& p2)
     {
         if (SDL_RenderDrawLine(get_pointer(), p1.x, p1.y, p2.x, p2.y) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto draw_line(const point& p1, const point& p2, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderDrawLine(get_pointer(), p1.x, p1.y, p2.x, p2.y));
+    }
+
     void draw_line_strip(span<const point> points)
     {
         if (!points.data()) {
@@ -216,17 +265,31 @@ public:
         }
         const auto sz = static_cast<int>(points.size());
         if (SDL_RenderDrawLines(get_pointer(), points.data(), sz) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto draw_line_strip(span<const point> points, std::nothrow_t) noexcept -> status
+    {
+        if (!points.data()) {
+            return {};
+        }
+        const auto sz = static_cast<int>(points.size());
+        return detail::make_status(SDL_RenderDrawLines(get_pointer(), points.data(), sz));
+    }
+
     void draw_point(const point& p)
     {
         if (SDL_RenderDrawPoint(get_pointer(), p.x, p.y) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto draw_point(const point& p, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderDrawPoint(get_pointer(), p.x, p.y));
+    }
+
     void draw_points(span<const point> points)
     {
         if (!points.data()) {
@@ -234,47 +297,246 @@ public:
         }
         const auto sz = static_cast<int>(points.size());
         if (SDL_RenderDrawPoints(get_pointer(), points.data(), sz) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto draw_points(span<const point> points, std::nothrow_t) noexcept -> status
+    {
+        if (!points.data()) {
+            return {};
         }
+        const auto sz = static_cast<int>(points.size());
+        return detail::make_status(SDL_RenderDrawPoints(get_pointer(), points.data(), sz));
     }
 
     void draw_rectangle(const rect& rect)
     {
         if (SDL_RenderDrawRect(get_pointer(), &rect) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto draw_rectangle(const rect& rect, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderDrawRect(get_pointer(), &rect));
+    }
+
     void draw_rectangles(span<const rect> rectangles)
     {
         if (!rectangles.data()) {
             return;
         }
         const auto sz = static_cast<int>(rectangles.size());
-        if (SDL_RenderDrawRects(get_pointer(), rectangles.data(), sz) == 0) {
-            throw error{};
+        if (SDL_RenderDrawRects(get_pointer(), rectangles.data(), sz) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto draw_rectangles(span<const rect> rectangles, std::nothrow_t) noexcept -> status
+    {
+        if (!rectangles.data()) {
+            return {};
+        }
+        const auto sz = static_cast<int>(rectangles.size());
+        return detail::make_status(SDL_RenderDrawRects(get_pointer(), rectangles.data(), sz));
+    }
+
     void fill_rectangle(const rect& rect)
     {
         if (SDL_RenderFillRect(get_pointer(), &rect) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto fill_rectangle(const rect& rect, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderFillRect(get_pointer(), &rect));
+    }
+
     void fill_rectangles(span<const rect> rectangles)
     {
         if (!rectangles.data()) return;
         const auto sz = static_cast<int>(rectangles.size());
         if (SDL_RenderFillRects(get_pointer(), rectangles.data(), sz) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto fill_rectangles(span<const rect> rectangles, std::nothrow_t) noexcept -> status
+    {
+        if (!rectangles.data()) {
+            return {};
+        }
+        const auto sz = static_cast<int>(rectangles.size());
+        return detail::make_status(SDL_RenderFillRects(get_pointer(), rectangles.data(), sz));
+    }
+
+#if SDLW_DETAIL_HAS_FLOAT_RECT
+    void draw_line(const fpoint& p1, const fpoint& p2)
+    {
+        if (SDL_RenderDrawLineF(get_pointer(), p1.x, p1.y, p2.x, p2.y) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto draw_line(const fpoint& p1, const fpoint& p2, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderDrawLineF(get_pointer(), p1.x, p1.y, p2.x, p2.y));
+    }
+
+    void draw_line_strip(span<const fpoint> points)
+    {
+        if (!points.data()) {
+            return;
+        }
+        const auto sz = static_cast<int>(points.size());
+        if (SDL_RenderDrawLinesF(get_pointer(), points.data(), sz) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto draw_line_strip(span<const fpoint> points, std::nothrow_t) noexcept -> status
+    {
+        if (!points.data()) {
+            return {};
+        }
+        const auto sz = static_cast<int>(points.size());
+        return detail::make_status(SDL_RenderDrawLinesF(get_pointer(), points.data(), sz));
+    }
+
+    void draw_point(const fpoint& p)
+    {
+        if (SDL_RenderDrawPointF(get_pointer(), p.x, p.y) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto draw_point(const fpoint& p, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderDrawPointF(get_pointer(), p.x, p.y));
+    }
+
+    void draw_points(span<const fpoint> points)
+    {
+        if (!points.data()) {
+            return;
+        }
+        const auto sz = static_cast<int>(points.size());
+        if (SDL_RenderDrawPointsF(get_pointer(), points.data(), sz) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto draw_points(span<const fpoint> points, std::nothrow_t) noexcept -> status
+    {
+        if (!points.data()) {
+            return {};
         }
+        const auto sz = static_cast<int>(points.size());
+        return detail::make_status(SDL_RenderDrawPointsF(get_pointer(), points.data(), sz));
     }
 
-    void copy(const texture&, const rect* src, const rect* dst);
+    void draw_rectangle(const frect& rect)
+    {
+        if (SDL_RenderDrawRectF(get_pointer(), &rect) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
 
-    void copy(const texture&, const rect* src, const rect* dst, double angle, const point* center, renderer_flip);
+    auto draw_rectangle(const frect& rect, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderDrawRectF(get_pointer(), &rect));
+    }
+
+    void draw_rectangles(span<const frect> rectangles)
+    {
+        if (!rectangles.data()) {
+            return;
+        }
+        const auto sz = static_cast<int>(rectangles.size());
+        if (SDL_RenderDrawRectsF(get_pointer(), rectangles.data(), sz) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto draw_rectangles(span<const frect> rectangles, std::nothrow_t) noexcept -> status
+    {
+        if (!rectangles.data()) {
+            return {};
+        }
+        const auto sz = static_cast<int>(rectangles.size());
+        return detail::make_status(SDL_RenderDrawRectsF(get_pointer(), rectangles.data(), sz));
+    }
+
+    void fill_rectangle(const frect& rect)
+    {
+        if (SDL_RenderFillRectF(get_pointer(), &rect) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto fill_rectangle(const frect& rect, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_RenderFillRectF(get_pointer(), &rect));
+    }
+
+    void fill_rectangles(span<const frect> rectangles)
+    {
+        if (!rectangles.data()) return;
+        const auto sz = static_cast<int>(rectangles.size());
+        if (SDL_RenderFillRectsF(get_pointer(), rectangles.data(), sz) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+    auto fill_rectangles(span<const frect> rectangles, std::nothrow_t) noexcept -> status
+    {
+        if (!rectangles.data()) {
+            return {};
+        }
+        const auto sz = static_cast<int>(rectangles.size());
+        return detail::make_status(SDL_RenderFillRectsF(get_pointer(), rectangles.data(), sz));
+    }
+#endif
+
+    void copy(const texture_ref&, const rect* src, const rect* dst);
+
+    void copy(const texture_ref&, const rect* src, const rect* dst, double angle, const point* center, renderer_flip);
+
+    void copy(const sub_texture&, const rect* dst);
+
+    void copy(const sub_texture&, const rect* dst, double angle, const point* center, renderer_flip);
+
+    auto copy(const texture_ref&, const rect* src, const rect* dst, std::nothrow_t) noexcept -> status;
+
+    auto copy(const texture_ref&, const rect* src, const rect* dst, double angle, const point* center, renderer_flip, std::nothrow_t) noexcept
+        -> status;
+
+    auto copy(const sub_texture&, const rect* dst, std::nothrow_t) noexcept -> status;
+
+    auto copy(const sub_texture&, const rect* dst, double angle, const point* center, renderer_flip, std::nothrow_t) noexcept -> status;
+
+#if SDLW_DETAIL_HAS_FLOAT_RECT
+    // Sub-pixel destinations. dst is a reference so that calls passing
+    // nullptr for it keep resolving to the integer overloads.
+    void copy(const texture_ref&, const rect* src, const frect& dst);
+
+    void copy(const texture_ref&, const rect* src, const frect& dst, double angle, const fpoint* center, renderer_flip);
+
+    void copy(const sub_texture&, const frect& dst);
+
+    void copy(const sub_texture&, const frect& dst, double angle, const fpoint* center, renderer_flip);
+
+    auto copy(const texture_ref&, const rect* src, const frect& dst, std::nothrow_t) noexcept -> status;
+
+    auto copy(const texture_ref&, const rect* src, const frect& dst, double angle, const fpoint* center, renderer_flip, std::nothrow_t) noexcept
+        -> status;
+
+    auto copy(const sub_texture&, const frect& dst, std::nothrow_t) noexcept -> status;
+
+    auto copy(const sub_texture&, const frect& dst, double angle, const fpoint* center, renderer_flip, std::nothrow_t) noexcept -> status;
+#endif
 
     void present() noexcept
     {
@@ -309,7 +571,7 @@ inline auto window::renderer() -> renderer_ref
     if (const auto ptr = SDL_GetRenderer(_window.get())) {
         return renderer_ref{ptr};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -360,10 +622,10 @@ public:
 inline auto renderer::info() const -> renderer_info
 {
     auto info = SDL_RendererInfo{};
-    if (SDL_GetRendererInfo(get_pointer(), &info) < 0) {
+    if (SDL_GetRendererInfo(get_pointer(), &info) == 0) {
         return renderer_info{info};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -377,34 +639,35 @@ enum class texture_access : int {
 
 // clang-format on
 
-class texture {
+// Non-owning, trivially copyable handle to an SDL_Texture. Format, access
+// and size never change for an existing texture, so they are read once when
+// the handle is made from a raw pointer and copied along with it after that.
+class texture_ref {
 public:
-    texture(class texture_ref) = delete;
-    explicit texture(SDL_Texture* t) noexcept : _texture{t} {}
-    auto get_pointer() const noexcept -> SDL_Texture* { return _texture.get(); }
+    texture_ref() = default;
 
-    texture(const renderer& r, pixel_format_type format, texture_access access, const sdl::size& sz)
-        : texture{SDL_CreateTexture(r.get_pointer(), static_cast<u32>(format), static_cast<int>(access), sz.w, sz.h)}
+    explicit texture_ref(SDL_Texture* t) noexcept
+        : _texture{t}
     {
-        if (!_texture) throw error{};
+        if (t) SDL_QueryTexture(t, &_format, &_access, &_size.w, &_size.h);
     }
 
-    texture(const renderer& rend, const surface& surf)
-        : texture{SDL_CreateTextureFromSurface(rend.get_pointer(), surf.get_pointer())}
+    explicit operator bool() const noexcept { return _texture != nullptr; }
+    auto get_pointer() const noexcept -> SDL_Texture* { return _texture; }
+
+    auto access() const noexcept -> texture_access
     {
-        if (!_texture) throw error{};
+        return static_cast<texture_access>(_access);
     }
 
-    auto access() const -> texture_access
+    auto format() const noexcept -> pixel_format_type
     {
-        const auto ptexture = get_pointer();
-        auto access = int{};
-        constexpr auto null = nullptr;
-        if (SDL_QueryTexture(ptexture, null, &access, null, null) == 0) {
-            return static_cast<texture_access>(access);
-        } else {
-            throw error{};
-        }
+        return static_cast<pixel_format_type>(_format);
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _size;
     }
 
     auto alpha_mod() const -> u8
@@ -413,7 +676,7 @@ public:
         if (SDL_GetTextureAlphaMod(get_pointer(), &alpha) == 0) {
             return alpha;
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -423,7 +686,7 @@ public:
         if (SDL_GetTextureBlendMode(get_pointer(), &mode) == 0) {
             return static_cast<sdl::blend_mode>(mode);
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -435,57 +698,47 @@ public:
         if (SDL_GetTextureColorMod(get_pointer(), &r, &g, &b) == 0) {
             return std::array{r, g, b};
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
-    auto format() const -> pixel_format_type
-    {
-        const auto ptexture = get_pointer();
-        auto format = u32{};
-        constexpr auto null = nullptr;
-        if (SDL_QueryTexture(ptexture, &format, null, null, null) == 0) {
-            return static_cast<pixel_format_type>(format);
-        } else {
-            throw error{};
-        }
-    }
-
-    auto size() const -> sdl::size
+    void set_alpha_mod(u8 alpha)
     {
-        const auto ptexture = get_pointer();
-        auto width = int();
-        auto height = int();
-        constexpr auto null = nullptr;
-        if (SDL_QueryTexture(ptexture, null, null, &width, &height) == 0) {
-            return sdl::size{width, height};
-        } else {
-            throw error{};
+        if (SDL_SetTextureAlphaMod(get_pointer(), alpha) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
-    void set_alpha_mod(u8 alpha)
+    auto set_alpha_mod(u8 alpha, std::nothrow_t) noexcept -> status
     {
-        if (SDL_SetTextureAlphaMod(get_pointer(), alpha) < 0) {
-            throw error{};
-        }
+        return detail::make_status(SDL_SetTextureAlphaMod(get_pointer(), alpha));
     }
 
     void set_blend_mode(sdl::blend_mode mode)
     {
         const auto sdl_blend_mode = static_cast<SDL_BlendMode>(mode);
         if (SDL_SetTextureBlendMode(get_pointer(), sdl_blend_mode) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_blend_mode(sdl::blend_mode mode, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetTextureBlendMode(get_pointer(), static_cast<SDL_BlendMode>(mode)));
+    }
+
     void set_color_mod(u8 red, u8 green, u8 blue)
     {
         if (SDL_SetTextureColorMod(get_pointer(), red, green, blue) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_color_mod(u8 red, u8 green, u8 blue, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetTextureColorMod(get_pointer(), red, green, blue));
+    }
+
     auto lock(const rect& area) -> std::tuple<void*, int>
     {
         auto pixels = static_cast<void*>(nullptr);
@@ -493,10 +746,20 @@ public:
         if (SDL_LockTexture(get_pointer(), &area, &pixels, &pitch) == 0) {
             return std::make_tuple(pixels, pitch);
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto lock(const rect& area, std::nothrow_t) noexcept -> expected<std::tuple<void*, int>>
+    {
+        auto pixels = static_cast<void*>(nullptr);
+        auto pitch = int{};
+        if (const auto result = SDL_LockTexture(get_pointer(), &area, &pixels, &pitch); result < 0) {
+            return unexpected{error_code{result}};
+        }
+        return std::make_tuple(pixels, pitch);
+    }
+
     void unlock() noexcept
     {
         SDL_UnlockTexture(get_pointer());
@@ -505,10 +768,15 @@ public:
     void update(const rect& rect, const void* pixels, int pitch)
     {
         if (SDL_UpdateTexture(get_pointer(), &rect, pixels, pitch) < 0) {
-            throw error();
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto update(const rect& rect, const void* pixels, int pitch, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_UpdateTexture(get_pointer(), &rect, pixels, pitch));
+    }
+
     void update_yuv(const rect& rect, const u8* yplane, int ypitch, const u8* uplane, int upitch, const u8* vplane, int vpitch)
     {
         const auto ptex = get_pointer();
@@ -517,68 +785,315 @@ public:
         const auto v = vplane;
         constexpr auto update = SDL_UpdateYUVTexture;
         if (update(ptex, &rect, y, ypitch, u, upitch, v, vpitch) < 0) {
-            throw error();
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
-protected:
-    std::unique_ptr<SDL_Texture, detail::make_functor<SDL_DestroyTexture>> _texture;
+private:
+    SDL_Texture* _texture = nullptr;
+    u32 _format = 0;
+    int _access = 0;
+    sdl::size _size = {0, 0};
 };
 
-inline auto operator==(const texture& lhs, const texture& rhs) noexcept -> bool
+// Owning texture. It holds its texture_ref privately so that nothing can
+// assign over the owned pointer, and converts to it so that every
+// non-owning API accepts a texture directly.
+class texture {
+public:
+    explicit texture(SDL_Texture* t) noexcept : _ref{t} {}
+
+    texture(const renderer& r, pixel_format_type format, texture_access access, const sdl::size& sz)
+        : texture{SDL_CreateTexture(r.get_pointer(), static_cast<u32>(format), static_cast<int>(access), sz.w, sz.h)}
+    {
+        if (!_ref) SDLW_DETAIL_THROW_ERROR();
+    }
+
+    texture(const renderer& rend, const surface& surf)
+        : texture{SDL_CreateTextureFromSurface(rend.get_pointer(), surf.get_pointer())}
+    {
+        if (!_ref) SDLW_DETAIL_THROW_ERROR();
+    }
+
+    texture(const texture&) = delete;
+    auto operator=(const texture&) -> texture& = delete;
+
+    texture(texture&& other) noexcept
+        : _ref{std::exchange(other._ref, texture_ref{})}
+    {}
+
+    auto operator=(texture&& other) noexcept -> texture&
+    {
+        if (this != &other) {
+            if (_ref) SDL_DestroyTexture(_ref.get_pointer());
+            _ref = std::exchange(other._ref, texture_ref{});
+        }
+        return *this;
+    }
+
+    ~texture()
+    {
+        if (_ref) SDL_DestroyTexture(_ref.get_pointer());
+    }
+
+    auto ref() const noexcept -> const texture_ref&
+    {
+        return _ref;
+    }
+
+    operator const texture_ref&() const noexcept
+    {
+        return _ref;
+    }
+
+    explicit operator bool() const noexcept { return static_cast<bool>(_ref); }
+    auto get_pointer() const noexcept -> SDL_Texture* { return _ref.get_pointer(); }
+
+    auto access() const noexcept -> texture_access
+    {
+        return _ref.access();
+    }
+
+    auto format() const noexcept -> pixel_format_type
+    {
+        return _ref.format();
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _ref.size();
+    }
+
+    auto alpha_mod() const -> u8
+    {
+        return _ref.alpha_mod();
+    }
+
+    auto blend_mode() const -> sdl::blend_mode
+    {
+        return _ref.blend_mode();
+    }
+
+    auto color_mod() const -> std::array<u8, 3>
+    {
+        return _ref.color_mod();
+    }
+
+    void set_alpha_mod(u8 alpha)
+    {
+        _ref.set_alpha_mod(alpha);
+    }
+
+    auto set_alpha_mod(u8 alpha, std::nothrow_t) noexcept -> status
+    {
+        return _ref.set_alpha_mod(alpha, std::nothrow);
+    }
+
+    void set_blend_mode(sdl::blend_mode mode)
+    {
+        _ref.set_blend_mode(mode);
+    }
+
+    auto set_blend_mode(sdl::blend_mode mode, std::nothrow_t) noexcept -> status
+    {
+        return _ref.set_blend_mode(mode, std::nothrow);
+    }
+
+    void set_color_mod(u8 red, u8 green, u8 blue)
+    {
+        _ref.set_color_mod(red, green, blue);
+    }
+
+    auto set_color_mod(u8 red, u8 green, u8 blue, std::nothrow_t) noexcept -> status
+    {
+        return _ref.set_color_mod(red, green, blue, std::nothrow);
+    }
+
+    auto lock(const rect& area) -> std::tuple<void*, int>
+    {
+        return _ref.lock(area);
+    }
+
+    auto lock(const rect& area, std::nothrow_t) noexcept -> expected<std::tuple<void*, int>>
+    {
+        return _ref.lock(area, std::nothrow);
+    }
+
+    void unlock() noexcept
+    {
+        _ref.unlock();
+    }
+
+    void update(const rect& rect, const void* pixels, int pitch)
+    {
+        _ref.update(rect, pixels, pitch);
+    }
+
+    auto update(const rect& rect, const void* pixels, int pitch, std::nothrow_t) noexcept -> status
+    {
+        return _ref.update(rect, pixels, pitch, std::nothrow);
+    }
+
+    void update_yuv(const rect& rect, const u8* yplane, int ypitch, const u8* uplane, int upitch, const u8* vplane, int vpitch)
+    {
+        _ref.update_yuv(rect, yplane, ypitch, uplane, upitch, vplane, vpitch);
+    }
+
+private:
+    texture_ref _ref;
+};
+
+static_assert(std::is_trivially_copyable_v<texture_ref>);
+
+inline auto operator==(const texture_ref& lhs, const texture_ref& rhs) noexcept -> bool
 {
     return lhs.get_pointer() == rhs.get_pointer();
 }
 
-inline auto operator!=(const texture& lhs, const texture& rhs) noexcept -> bool
+inline auto operator!=(const texture_ref& lhs, const texture_ref& rhs) noexcept -> bool
 {
     return !(lhs == rhs);
 }
 
-inline void renderer::set_target(texture& t)
+inline void renderer::set_target(const texture_ref& t)
 {
     if (SDL_SetRenderTarget(_renderer.get(), t.get_pointer()) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
-inline void renderer::copy(const texture& tex, const rect* source, const rect* destination)
+inline auto renderer::set_target(const texture_ref& t, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_SetRenderTarget(_renderer.get(), t.get_pointer()));
+}
+
+inline void renderer::copy(const texture_ref& tex, const rect* source, const rect* destination)
 {
     if (SDL_RenderCopy(get_pointer(), tex.get_pointer(), source, destination) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
-inline void renderer::copy(const texture& t, const rect* src, const rect* dst, double angle, const point* center, renderer_flip f)
+inline void renderer::copy(const texture_ref& t, const rect* src, const rect* dst, double angle, const point* center, renderer_flip f)
 {
     if (SDL_RenderCopyEx(get_pointer(), t.get_pointer(), src, dst, angle, center, static_cast<SDL_RendererFlip>(f)) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
-class texture_ref : public texture {
-public:
-    explicit operator bool() const noexcept { return static_cast<bool>(_texture); }
-    explicit texture_ref(SDL_Texture* t) noexcept : texture{t} {}
-    ~texture_ref() { _texture.release(); }
+inline auto renderer::copy(const texture_ref& tex, const rect* source, const rect* destination, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_RenderCopy(get_pointer(), tex.get_pointer(), source, destination));
+}
+
+inline auto renderer::copy(
+    const texture_ref& t,
+    const rect* src,
+    const rect* dst,
+    double angle,
+    const point* center,
+    renderer_flip f,
+    std::nothrow_t) noexcept -> status
+{
+    const auto flip = static_cast<SDL_RendererFlip>(f);
+    return detail::make_status(SDL_RenderCopyEx(get_pointer(), t.get_pointer(), src, dst, angle, center, flip));
+}
+
+struct sub_texture {
+    const texture_ref* texture = nullptr;
+    rect area = {};
+
+    explicit operator bool() const noexcept { return texture != nullptr; }
 };
 
-inline auto renderer::target() -> texture_ref
+inline void renderer::copy(const sub_texture& st, const rect* dst)
 {
-    if (const auto ptr = SDL_GetRenderTarget(_renderer.get())) {
-        return texture_ref{ptr};
-    } else {
-        throw error{};
+    copy(*st.texture, &st.area, dst);
+}
+
+inline void renderer::copy(const sub_texture& st, const rect* dst, double angle, const point* center, renderer_flip f)
+{
+    copy(*st.texture, &st.area, dst, angle, center, f);
+}
+
+inline auto renderer::copy(const sub_texture& st, const rect* dst, std::nothrow_t) noexcept -> status
+{
+    return copy(*st.texture, &st.area, dst, std::nothrow);
+}
+
+inline auto renderer::copy(const sub_texture& st, const rect* dst, double angle, const point* center, renderer_flip f, std::nothrow_t) noexcept
+    -> status
+{
+    return copy(*st.texture, &st.area, dst, angle, center, f, std::nothrow);
+}
+
+#if SDLW_DETAIL_HAS_FLOAT_RECT
+inline void renderer::copy(const texture_ref& t, const rect* src, const frect& dst)
+{
+    if (SDL_RenderCopyF(get_pointer(), t.get_pointer(), src, &dst) < 0) {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline void renderer::copy(const texture_ref& t, const rect* src, const frect& dst, double angle, const fpoint* center, renderer_flip f)
+{
+    if (SDL_RenderCopyExF(get_pointer(), t.get_pointer(), src, &dst, angle, center, static_cast<SDL_RendererFlip>(f)) < 0) {
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline void renderer::copy(const sub_texture& st, const frect& dst)
+{
+    copy(*st.texture, &st.area, dst);
+}
+
+inline void renderer::copy(const sub_texture& st, const frect& dst, double angle, const fpoint* center, renderer_flip f)
+{
+    copy(*st.texture, &st.area, dst, angle, center, f);
+}
+
+inline auto renderer::copy(const texture_ref& t, const rect* src, const frect& dst, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_RenderCopyF(get_pointer(), t.get_pointer(), src, &dst));
+}
+
+inline auto renderer::copy(
+    const texture_ref& t,
+    const rect* src,
+    const frect& dst,
+    double angle,
+    const fpoint* center,
+    renderer_flip f,
+    std::nothrow_t) noexcept -> status
+{
+    const auto flip = static_cast<SDL_RendererFlip>(f);
+    return detail::make_status(SDL_RenderCopyExF(get_pointer(), t.get_pointer(), src, &dst, angle, center, flip));
+}
+
+inline auto renderer::copy(const sub_texture& st, const frect& dst, std::nothrow_t) noexcept -> status
+{
+    return copy(*st.texture, &st.area, dst, std::nothrow);
+}
+
+inline auto renderer::copy(const sub_texture& st, const frect& dst, double angle, const fpoint* center, renderer_flip f, std::nothrow_t) noexcept
+    -> status
+{
+    return copy(*st.texture, &st.area, dst, angle, center, f, std::nothrow);
+}
+#endif
+
+inline auto renderer::target() const noexcept -> texture_ref
+{
+    return texture_ref{SDL_GetRenderTarget(_renderer.get())};
+}
+
 struct render_driver {
     static auto count() -> int
     {
         if (const auto number = SDL_GetNumRenderDrivers(); number >= 0) {
             return number;
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -588,7 +1103,7 @@ struct render_driver {
         if (SDL_GetRenderDriverInfo(driver_index, &info) == 0) {
             return renderer_info{info};
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 };
@@ -604,27 +1119,27 @@ inline auto make_window_and_renderer(const size& window_size, enum window::flags
     if (SDL_CreateWindowAndRenderer(w, h, flags_, &pwindow, &prenderer) == 0) {
         return std::make_pair(window(pwindow), renderer(prenderer));
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
 namespace gl {
 
-inline auto bind_texture(texture& t) -> std::pair<float, float>
+inline auto bind_texture(const texture_ref& t) -> std::pair<float, float>
 {
     auto texw = float{};
     auto texh = float{};
     if (SDL_GL_BindTexture(t.get_pointer(), &texw, &texh) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return std::make_pair(texw, texh);
     }
 }
 
-inline void unbind_texture(texture& t)
+inline void unbind_texture(const texture_ref& t)
 {
     if (SDL_GL_UnbindTexture(t.get_pointer()) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <optional>
+
+#include <SDL2/SDL_render.h>
+
+#include <sdlw/blend_mode.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+
+namespace sdl {
+
+// Shadows the renderer's draw color, blend mode, target, clip and viewport
+// and skips setter calls that would not change anything. The shadow starts
+// out unknown, so the first call of each setter always reaches SDL, and a
+// setter that throws leaves its piece of state unknown again. Call
+// invalidate() after anything touches the renderer behind the cache's back
+// (raw SDL_Renderer* code, set_logical_size(), set_scale(), a device reset).
+class render_state_cache {
+public:
+    explicit render_state_cache(renderer& r) noexcept
+        : _renderer{r}
+    {}
+
+    render_state_cache(const render_state_cache&) = delete;
+    auto operator=(const render_state_cache&) -> render_state_cache& = delete;
+
+    auto get_renderer() const noexcept -> renderer&
+    {
+        return _renderer;
+    }
+
+    void set_draw_color(color c)
+    {
+        if (_draw_color && *_draw_color == c) {
+            ++_elided_calls;
+            return;
+        }
+        _draw_color = std::nullopt;
+        _renderer.set_draw_color(c);
+        _draw_color = c;
+        ++_issued_calls;
+    }
+
+    void set_draw_blend_mode(blend_mode mode)
+    {
+        if (_blend_mode == mode) {
+            ++_elided_calls;
+            return;
+        }
+        _blend_mode = std::nullopt;
+        _renderer.set_draw_blend_mode(mode);
+        _blend_mode = mode;
+        ++_issued_calls;
+    }
+
+    // Also accepts a null texture_ref, which selects the default target.
+    void set_target(const texture_ref& t)
+    {
+        if (_target == t.get_pointer()) {
+            ++_elided_calls;
+            return;
+        }
+        _target = std::nullopt;
+        _renderer.set_target(t);
+        _target = t.get_pointer();
+        // SDL swaps in the target's own viewport and clip rectangle.
+        _viewport = std::nullopt;
+        _clip = std::nullopt;
+        ++_issued_calls;
+    }
+
+    void set_clip(const rect& r)
+    {
+        if (_clip == r) {
+            ++_elided_calls;
+            return;
+        }
+        _clip = std::nullopt;
+        _renderer.set_clip(r);
+        _clip = r;
+        ++_issued_calls;
+    }
+
+    void set_viewport(const rect& r)
+    {
+        if (_viewport == r) {
+            ++_elided_calls;
+            return;
+        }
+        _viewport = std::nullopt;
+        _renderer.set_viewport(r);
+        _viewport = r;
+        ++_issued_calls;
+    }
+
+    // Forgets all shadowed state; the next call of every setter goes to SDL.
+    void invalidate() noexcept
+    {
+        _draw_color = std::nullopt;
+        _blend_mode = std::nullopt;
+        _target = std::nullopt;
+        _clip = std::nullopt;
+        _viewport = std::nullopt;
+    }
+
+    // Number of setter calls skipped because the state was already current.
+    auto elided_calls() const noexcept -> u64
+    {
+        return _elided_calls;
+    }
+
+    // Number of setter calls forwarded to SDL.
+    auto issued_calls() const noexcept -> u64
+    {
+        return _issued_calls;
+    }
+
+    void reset_counters() noexcept
+    {
+        _elided_calls = 0;
+        _issued_calls = 0;
+    }
+
+private:
+    renderer& _renderer;
+    std::optional<color> _draw_color;
+    std::optional<blend_mode> _blend_mode;
+    std::optional<SDL_Texture*> _target;
+    std::optional<rect> _clip;
+    std::optional<rect> _viewport;
+    u64 _elided_calls = 0;
+    u64 _issued_calls = 0;
+};
+
+} // namespace sdl
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <list>
+#include <utility>
+
+#include <sdlw/events.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+
+namespace sdl {
+
+// Recycles render-target textures by (size, format). acquire() hands out a
+// lease that returns its texture to the pool when destroyed; contents and
+// texture state (blend mode, mods) are whatever the previous holder left.
+// Call end_frame() once per frame so entries idle for more than
+// idle_frames frames get destroyed, and forward events to handle_event() so
+// textures are recreated after a render device reset. Leases must not
+// outlive the pool.
+class render_target_pool {
+    struct entry {
+        sdl::texture texture;
+        sdl::size size;
+        pixel_format_type format;
+        bool leased;
+        u64 last_used;
+    };
+
+public:
+    class lease {
+    public:
+        lease() = default;
+
+        lease(const lease&) = delete;
+        auto operator=(const lease&) -> lease& = delete;
+
+        lease(lease&& other) noexcept
+            : _pool{std::exchange(other._pool, nullptr)}
+            , _entry{other._entry}
+        {}
+
+        auto operator=(lease&& other) noexcept -> lease&
+        {
+            if (this != &other) {
+                release();
+                _pool = std::exchange(other._pool, nullptr);
+                _entry = other._entry;
+            }
+            return *this;
+        }
+
+        ~lease()
+        {
+            release();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _pool != nullptr;
+        }
+
+        // Stays valid across device resets; the pool swaps the texture in
+        // place, so re-fetch instead of holding on to a texture_ref copy.
+        auto texture() const noexcept -> sdl::texture&
+        {
+            return _entry->texture;
+        }
+
+        void release() noexcept
+        {
+            if (_pool) {
+                _pool->give_back(_entry);
+                _pool = nullptr;
+            }
+        }
+
+    private:
+        friend class render_target_pool;
+
+        lease(render_target_pool* pool, std::list<entry>::iterator e) noexcept
+            : _pool{pool}
+            , _entry{e}
+        {}
+
+        render_target_pool* _pool = nullptr;
+        std::list<entry>::iterator _entry = {};
+    };
+
+    explicit render_target_pool(renderer& r, int idle_frames = 3) noexcept
+        : _renderer{r}
+        , _idle_frames{idle_frames}
+    {}
+
+    render_target_pool(const render_target_pool&) = delete;
+    auto operator=(const render_target_pool&) -> render_target_pool& = delete;
+
+    auto acquire(const sdl::size& sz, pixel_format_type format = pixel_format_type::argb8888) -> lease
+    {
+        for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+            if (!it->leased && it->size == sz && it->format == format) {
+                it->leased = true;
+                ++_leased;
+                return lease{this, it};
+            }
+        }
+        _entries.push_front(entry{create(sz, format), sz, format, true, _frame});
+        ++_leased;
+        return lease{this, _entries.begin()};
+    }
+
+    // Advances the frame counter and destroys textures that have sat idle
+    // for more than idle_frames frames.
+    void end_frame()
+    {
+        ++_frame;
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            if (!it->leased && _frame - it->last_used > static_cast<u64>(_idle_frames)) {
+                it = _entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void handle_event(const event& e)
+    {
+        switch (e.type()) {
+        case event_type::render_targets_reset: ++_reset_count; break;
+        case event_type::render_device_reset: recreate(); break;
+        default: break;
+        }
+    }
+
+    // Recreates every texture, leased ones included. Only needed after the
+    // renderer lost its device; handle_event() calls it for you.
+    void recreate()
+    {
+        for (auto& e : _entries) {
+            e.texture = create(e.size, e.format);
+        }
+        ++_reset_count;
+    }
+
+    // Drops every texture that is not currently leased.
+    void trim() noexcept
+    {
+        _entries.remove_if([](const entry& e) { return !e.leased; });
+    }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return _entries.size();
+    }
+
+    auto leased_count() const noexcept -> std::size_t
+    {
+        return _leased;
+    }
+
+    // Bumped whenever pooled contents were lost; compare against a stored
+    // value to know when cached renderings must be redrawn.
+    auto reset_count() const noexcept -> u64
+    {
+        return _reset_count;
+    }
+
+private:
+    auto create(const sdl::size& sz, pixel_format_type format) -> sdl::texture
+    {
+        return sdl::texture{_renderer, format, texture_access::target, sz};
+    }
+
+    void give_back(std::list<entry>::iterator e) noexcept
+    {
+        e->leased = false;
+        e->last_used = _frame;
+        --_leased;
+    }
+
+    renderer& _renderer;
+    int _idle_frames;
+    std::list<entry> _entries;
+    std::size_t _leased = 0;
+    u64 _frame = 0;
+    u64 _reset_count = 0;
+};
+
+} // namespace sdl
@@ -0,0 +1,453 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/surface.hpp>
+#include <sdlw/worker_pool.hpp>
+
+#include "sdlw/detail/simd.hpp"
+
+namespace sdl {
+
+// clang-format off
+
+enum class resample_filter {
+    box,
+    bilinear,
+    lanczos3
+};
+
+// clang-format on
+
+namespace detail {
+
+// Weights are 2.14 fixed point, so every kernel computes the same sums
+// exactly and the SIMD paths match the scalar one bit for bit.
+constexpr auto resample_bits = 14;
+constexpr auto resample_half = 1 << (resample_bits - 1);
+
+inline auto filter_support(resample_filter f) noexcept -> double
+{
+    switch (f) {
+    case resample_filter::box: return 0.5;
+    case resample_filter::bilinear: return 1.0;
+    case resample_filter::lanczos3: return 3.0;
+    }
+    return 1.0;
+}
+
+inline auto filter_weight(resample_filter f, double x) noexcept -> double
+{
+    switch (f) {
+    case resample_filter::box: return x >= -0.5 && x < 0.5 ? 1.0 : 0.0;
+    case resample_filter::bilinear: return std::max(1.0 - std::abs(x), 0.0);
+    case resample_filter::lanczos3:
+        if (x == 0.0) return 1.0;
+        if (std::abs(x) >= 3.0) return 0.0;
+        {
+            const auto px = 3.14159265358979323846 * x;
+            return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+        }
+    }
+    return 0.0;
+}
+
+// For each output pixel of one axis: the first input pixel it reads, how
+// many it reads and their weights, padded to taps per pixel. When
+// shrinking, the filter is stretched over the input so every input pixel
+// contributes.
+struct resample_weights {
+    int taps = 0;
+    std::vector<int> start;
+    std::vector<int> count;
+    std::vector<i16> weights;
+};
+
+inline auto make_resample_weights(resample_filter f, int in_size, int out_size) -> resample_weights
+{
+    const auto scale = static_cast<double>(in_size) / out_size;
+    const auto stretch = std::max(scale, 1.0);
+    const auto support = filter_support(f) * stretch;
+
+    auto w = resample_weights{};
+    w.taps = static_cast<int>(std::ceil(support)) * 2 + 1;
+    w.start.resize(static_cast<std::size_t>(out_size));
+    w.count.resize(static_cast<std::size_t>(out_size));
+    w.weights.assign(static_cast<std::size_t>(out_size) * static_cast<std::size_t>(w.taps), 0);
+
+    auto k = std::vector<double>(static_cast<std::size_t>(w.taps));
+    for (auto i = 0; i < out_size; ++i) {
+        const auto center = (i + 0.5) * scale;
+        const auto first = std::max(static_cast<int>(center - support + 0.5), 0);
+        const auto last = std::min(static_cast<int>(center + support + 0.5), in_size);
+        const auto n = std::clamp(last - first, 1, w.taps);
+        auto total = 0.0;
+        for (auto t = 0; t < n; ++t) {
+            k[static_cast<std::size_t>(t)] = filter_weight(f, (first + t - center + 0.5) / stretch);
+            total += k[static_cast<std::size_t>(t)];
+        }
+        const auto out = &w.weights[static_cast<std::size_t>(i) * static_cast<std::size_t>(w.taps)];
+        auto sum = 0;
+        auto largest = 0;
+        for (auto t = 0; t < n; ++t) {
+            const auto v = total != 0.0 ? k[static_cast<std::size_t>(t)] / total : (t == 0 ? 1.0 : 0.0);
+            out[t] = static_cast<i16>(std::lround(v * (1 << resample_bits)));
+            sum += out[t];
+            if (out[t] > out[largest]) largest = t;
+        }
+        // Rounding leaves the row a few units off; put the residual on the
+        // largest tap so flat areas keep their exact value.
+        out[largest] = static_cast<i16>(out[largest] + ((1 << resample_bits) - sum));
+        w.start[static_cast<std::size_t>(i)] = std::min(first, in_size - n);
+        w.count[static_cast<std::size_t>(i)] = n;
+    }
+    return w;
+}
+
+constexpr auto resample_clamp(int acc) noexcept -> u8
+{
+    return static_cast<u8>(std::clamp(acc >> resample_bits, 0, 255));
+}
+
+// Horizontal pass over one row of 4-byte pixels.
+inline void resample_row_scalar(const u8* src, u8* dst, const resample_weights& w) noexcept
+{
+    const auto out_size = static_cast<int>(w.start.size());
+    for (auto x = 0; x < out_size; ++x, dst += 4) {
+        const auto k = &w.weights[static_cast<std::size_t>(x) * static_cast<std::size_t>(w.taps)];
+        const auto s = src + w.start[static_cast<std::size_t>(x)] * 4;
+        int acc[4] = {resample_half, resample_half, resample_half, resample_half};
+        for (auto t = 0; t < w.count[static_cast<std::size_t>(x)]; ++t) {
+            for (auto c = 0; c < 4; ++c) {
+                acc[c] += k[t] * s[t * 4 + c];
+            }
+        }
+        for (auto c = 0; c < 4; ++c) {
+            dst[c] = resample_clamp(acc[c]);
+        }
+    }
+}
+
+// Vertical pass: byte i of dst from byte i of count rows, stride apart.
+inline void resample_column_scalar(const u8* src, std::ptrdiff_t stride, int count, const i16* k, u8* dst, int bytes) noexcept
+{
+    for (auto i = 0; i < bytes; ++i) {
+        auto acc = resample_half;
+        for (auto t = 0; t < count; ++t) {
+            acc += k[t] * src[t * stride + i];
+        }
+        dst[i] = resample_clamp(acc);
+    }
+}
+
+#if defined(SDLW_DETAIL_SIMD_X86)
+
+// Two 16-bit weights repeated for _mm_madd_epi16 over interleaved taps.
+inline auto weight_pair(i16 a, i16 b) noexcept -> int
+{
+    return static_cast<int>(static_cast<u16>(a) | static_cast<u32>(static_cast<u16>(b)) << 16);
+}
+
+SDLW_DETAIL_TARGET("sse2") inline void resample_row_sse2(const u8* src, u8* dst, const resample_weights& w) noexcept
+{
+    const auto zero = _mm_setzero_si128();
+    const auto out_size = static_cast<int>(w.start.size());
+    for (auto x = 0; x < out_size; ++x, dst += 4) {
+        const auto k = &w.weights[static_cast<std::size_t>(x) * static_cast<std::size_t>(w.taps)];
+        const auto s = src + w.start[static_cast<std::size_t>(x)] * 4;
+        const auto n = w.count[static_cast<std::size_t>(x)];
+        auto acc = _mm_set1_epi32(resample_half);
+        auto t = 0;
+        for (; t + 1 < n; t += 2) {
+            // Two pixels to a0 b0 a1 b1 a2 b2 a3 b3, one madd per channel.
+            const auto p = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + t * 4)), zero);
+            const auto ab = _mm_unpacklo_epi16(p, _mm_srli_si128(p, 8));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(ab, _mm_set1_epi32(weight_pair(k[t], k[t + 1]))));
+        }
+        if (t < n) {
+            auto last = 0;
+            std::memcpy(&last, s + t * 4, 4);
+            const auto p = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(last), zero), zero);
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(p, _mm_set1_epi32(weight_pair(k[t], 0))));
+        }
+        const auto v = _mm_srai_epi32(acc, resample_bits);
+        const auto packed = _mm_packus_epi16(_mm_packs_epi32(v, v), zero);
+        const auto out = _mm_cvtsi128_si32(packed);
+        std::memcpy(dst, &out, 4);
+    }
+}
+
+SDLW_DETAIL_TARGET("sse2")
+inline auto resample_column_sse2(const u8* src, std::ptrdiff_t stride, int count, const i16* k, u8* dst, int bytes) noexcept -> int
+{
+    const auto zero = _mm_setzero_si128();
+    auto i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        auto acc0 = _mm_set1_epi32(resample_half);
+        auto acc1 = acc0;
+        auto acc2 = acc0;
+        auto acc3 = acc0;
+        for (auto t = 0; t < count; t += 2) {
+            const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + t * stride + i));
+            const auto b = t + 1 < count ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (t + 1) * stride + i)) : zero;
+            const auto wk = _mm_set1_epi32(weight_pair(k[t], t + 1 < count ? k[t + 1] : 0));
+            const auto lo = _mm_unpacklo_epi8(a, zero);
+            const auto hi = _mm_unpackhi_epi8(a, zero);
+            const auto blo = _mm_unpacklo_epi8(b, zero);
+            const auto bhi = _mm_unpackhi_epi8(b, zero);
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi16(lo, blo), wk));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi16(lo, blo), wk));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi16(hi, bhi), wk));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi16(hi, bhi), wk));
+        }
+        const auto lo = _mm_packs_epi32(_mm_srai_epi32(acc0, resample_bits), _mm_srai_epi32(acc1, resample_bits));
+        const auto hi = _mm_packs_epi32(_mm_srai_epi32(acc2, resample_bits), _mm_srai_epi32(acc3, resample_bits));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+SDLW_DETAIL_TARGET("avx2")
+inline auto resample_column_avx2(const u8* src, std::ptrdiff_t stride, int count, const i16* k, u8* dst, int bytes) noexcept -> int
+{
+    const auto zero = _mm256_setzero_si256();
+    auto i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        auto acc0 = _mm256_set1_epi32(resample_half);
+        auto acc1 = acc0;
+        auto acc2 = acc0;
+        auto acc3 = acc0;
+        for (auto t = 0; t < count; t += 2) {
+            const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + t * stride + i));
+            const auto b = t + 1 < count ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (t + 1) * stride + i)) : zero;
+            const auto wk = _mm256_set1_epi32(weight_pair(k[t], t + 1 < count ? k[t + 1] : 0));
+            const auto lo = _mm256_unpacklo_epi8(a, zero);
+            const auto hi = _mm256_unpackhi_epi8(a, zero);
+            const auto blo = _mm256_unpacklo_epi8(b, zero);
+            const auto bhi = _mm256_unpackhi_epi8(b, zero);
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi16(lo, blo), wk));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi16(lo, blo), wk));
+            acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi16(hi, bhi), wk));
+            acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi16(hi, bhi), wk));
+        }
+        // Unpacking and packing both work within 128-bit lanes, so the
+        // bytes come back in order.
+        const auto lo = _mm256_packs_epi32(_mm256_srai_epi32(acc0, resample_bits), _mm256_srai_epi32(acc1, resample_bits));
+        const auto hi = _mm256_packs_epi32(_mm256_srai_epi32(acc2, resample_bits), _mm256_srai_epi32(acc3, resample_bits));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+#endif
+
+inline void resample_row(const u8* src, u8* dst, const resample_weights& w) noexcept
+{
+#if defined(SDLW_DETAIL_SIMD_X86)
+    if (simd_support() >= simd_level::sse2) {
+        resample_row_sse2(src, dst, w);
+        return;
+    }
+#endif
+    resample_row_scalar(src, dst, w);
+}
+
+inline void resample_column(const u8* src, std::ptrdiff_t stride, int count, const i16* k, u8* dst, int bytes) noexcept
+{
+    auto done = 0;
+#if defined(SDLW_DETAIL_SIMD_X86)
+    const auto level = simd_support();
+    if (level == simd_level::avx2) done = resample_column_avx2(src, stride, count, k, dst, bytes);
+    if (level >= simd_level::sse2) done += resample_column_sse2(src + done, stride, count, k, dst + done, bytes - done);
+#endif
+    resample_column_scalar(src + done, stride, count, k, dst + done, bytes - done);
+}
+
+// Runs body(first, last) over [0, count) in pieces, on pool when there is
+// one.
+template<typename Body>
+void resample_split(worker_pool* pool, int count, Body&& body)
+{
+    if (!pool || pool->thread_count() == 1) {
+        body(0, count);
+        return;
+    }
+    const auto pieces = std::min(count, pool->thread_count() * 4);
+    pool->for_each(pieces, [&](int i) {
+        body(static_cast<int>(static_cast<i64>(count) * i / pieces), static_cast<int>(static_cast<i64>(count) * (i + 1) / pieces));
+    });
+}
+
+// Resamples 4-byte pixels of any channel order from src to dst.
+inline void resample_pixels(
+    worker_pool* pool,
+    const u8* src,
+    int src_pitch,
+    const sdl::size& src_size,
+    u8* dst,
+    int dst_pitch,
+    const sdl::size& dst_size,
+    resample_filter filter)
+{
+    const auto row_bytes = dst_size.w * 4;
+
+    // Horizontal pass into a tightly packed buffer, skipped when only the
+    // height changes.
+    auto wide = std::vector<u8>{};
+    auto mid = src;
+    auto mid_pitch = static_cast<std::ptrdiff_t>(src_pitch);
+    if (src_size.w != dst_size.w) {
+        const auto wx = make_resample_weights(filter, src_size.w, dst_size.w);
+        const auto into = src_size.h == dst_size.h ? dst : nullptr;
+        if (!into) wide.resize(static_cast<std::size_t>(row_bytes) * static_cast<std::size_t>(src_size.h));
+        const auto out = into ? into : wide.data();
+        const auto out_pitch = into ? static_cast<std::ptrdiff_t>(dst_pitch) : row_bytes;
+        resample_split(pool, src_size.h, [&](int first, int last) {
+            for (auto y = first; y < last; ++y) {
+                resample_row(src + y * static_cast<std::ptrdiff_t>(src_pitch), out + y * out_pitch, wx);
+            }
+        });
+        if (into) return;
+        mid = wide.data();
+        mid_pitch = row_bytes;
+    }
+
+    if (src_size.h == dst_size.h) {
+        for (auto y = 0; y < dst_size.h; ++y) {
+            std::copy_n(mid + y * mid_pitch, row_bytes, dst + y * static_cast<std::ptrdiff_t>(dst_pitch));
+        }
+        return;
+    }
+
+    const auto wy = make_resample_weights(filter, src_size.h, dst_size.h);
+    resample_split(pool, dst_size.h, [&](int first, int last) {
+        for (auto y = first; y < last; ++y) {
+            const auto k = &wy.weights[static_cast<std::size_t>(y) * static_cast<std::size_t>(wy.taps)];
+            const auto rows = mid + wy.start[static_cast<std::size_t>(y)] * mid_pitch;
+            const auto count = wy.count[static_cast<std::size_t>(y)];
+            resample_column(rows, mid_pitch, count, k, dst + y * static_cast<std::ptrdiff_t>(dst_pitch), row_bytes);
+        }
+    });
+}
+
+// Formats whose four channels are whole bytes, which the kernels filter as
+// is. ARGB2101010 is 4 bytes too, but its channels straddle bytes.
+constexpr auto resample_direct(pixel_format_type f) noexcept -> bool
+{
+    return !is_fourcc(f) && layout(f) == pixel_layout::_8888;
+}
+
+inline auto resample_surface(worker_pool* pool, const surface& src, surface& dst, resample_filter filter) -> status
+{
+    const auto s = src.get_pointer();
+    const auto d = dst.get_pointer();
+    if (s->w <= 0 || s->h <= 0 || d->w <= 0 || d->h <= 0) {
+        set_error("sdl::resample: empty surface");
+        return unexpected{error_code{}};
+    }
+    if (src.must_lock() || dst.must_lock()) {
+        set_error("sdl::resample: RLE surfaces are not supported");
+        return unexpected{error_code{}};
+    }
+
+    // Filtering works on any 8888 format as long as both sides share it;
+    // anything else goes through ARGB8888.
+    const auto src_format = static_cast<pixel_format_type>(s->format->format);
+    const auto dst_format = static_cast<pixel_format_type>(d->format->format);
+    const auto work_format = resample_direct(dst_format) ? dst_format : pixel_format_type::argb8888;
+
+    auto in = std::vector<u8>{};
+    auto in_pixels = static_cast<const u8*>(s->pixels);
+    auto in_pitch = s->pitch;
+    if (src_format != work_format) {
+        in_pitch = s->w * 4;
+        in.resize(static_cast<std::size_t>(in_pitch) * static_cast<std::size_t>(s->h));
+        const auto converted = convert_pixels(s->w, s->h, src_format, s->pixels, s->pitch, work_format, in.data(), in_pitch, std::nothrow);
+        if (!converted) return converted;
+        in_pixels = in.data();
+    }
+
+    auto out = std::vector<u8>{};
+    auto out_pixels = static_cast<u8*>(d->pixels);
+    auto out_pitch = d->pitch;
+    if (dst_format != work_format) {
+        out_pitch = d->w * 4;
+        out.resize(static_cast<std::size_t>(out_pitch) * static_cast<std::size_t>(d->h));
+        out_pixels = out.data();
+    }
+
+    resample_pixels(pool, in_pixels, in_pitch, {s->w, s->h}, out_pixels, out_pitch, {d->w, d->h}, filter);
+
+    if (dst_format != work_format) {
+        return convert_pixels(d->w, d->h, work_format, out.data(), out_pitch, dst_format, d->pixels, d->pitch, std::nothrow);
+    }
+    return {};
+}
+
+// The scratch buffers and weight tables are allocated per call; running out
+// of memory is reported like any other failure.
+inline auto resample(worker_pool* pool, const surface& src, surface& dst, resample_filter filter) noexcept -> status
+{
+#if !defined(SDLW_NO_EXCEPTIONS)
+    try {
+#endif
+        return resample_surface(pool, src, dst, filter);
+#if !defined(SDLW_NO_EXCEPTIONS)
+    } catch (const std::bad_alloc&) {
+        set_error("sdl::resample: out of memory");
+        return unexpected{error_code{}};
+    }
+#endif
+}
+
+} // namespace detail
+
+// Scales all of src onto all of dst with a separable filter: box averages,
+// bilinear interpolates, and Lanczos-3 keeps the most detail at the cost
+// of slight ringing. Shrinking widens the filter so no source pixel is
+// skipped. Channels, alpha included, are filtered independently, so
+// straight-alpha images with soft edges are best premultiplied first.
+// 8888 formats are filtered in place; other formats go through ARGB8888.
+inline void resample(const surface& src, surface& dst, resample_filter filter)
+{
+    if (!detail::resample(nullptr, src, dst, filter)) {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto resample(const surface& src, surface& dst, resample_filter filter, std::nothrow_t) noexcept -> status
+{
+    return detail::resample(nullptr, src, dst, filter);
+}
+
+// Same as above with both passes split across pool.
+inline void resample(worker_pool& pool, const surface& src, surface& dst, resample_filter filter)
+{
+    if (!detail::resample(&pool, src, dst, filter)) {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto resample(worker_pool& pool, const surface& src, surface& dst, resample_filter filter, std::nothrow_t) noexcept -> status
+{
+    return detail::resample(&pool, src, dst, filter);
+}
+
+// Returns a new surface of the given size in src's format, or ARGB8888 for
+// formats other than 8888 ones.
+inline auto resample(const surface& src, const sdl::size& size, resample_filter filter) -> surface
+{
+    const auto format = src.format().format();
+    auto dst = surface{size.w, size.h, 32, detail::resample_direct(format) ? format : pixel_format_type::argb8888};
+    resample(src, dst, filter);
+    return dst;
+}
+
+} // namespace sdl
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <new>
+
 #include <SDL2/SDL_rwops.h>
 
 #include <sdlw/error.hpp>
@@ -11,28 +13,32 @@ class stream {
 public:
     stream() noexcept
     {
+        // SDL hands the callbacks the embedded SDL_RWops, not the stream, so
+        // keep a way back to the object that owns it.
+        _rwops.hidden.unknown.data1 = this;
+
         _rwops.size = [](SDL_RWops* context) -> i64 {
-            const auto& s = *reinterpret_cast<stream*>(context);
+            const auto& s = self(context);
             return s.size();
         };
 
         _rwops.seek = [](SDL_RWops* context, i64 offset, int whence) -> i64 {
-            auto& s = *reinterpret_cast<stream*>(context);
+            auto& s = self(context);
             return s.seek(offset, whence);
         };
 
         _rwops.read = [](SDL_RWops* context, void* ptr, std::size_t size, std::size_t maxnum) -> std::size_t {
-            auto& s = *reinterpret_cast<stream*>(context);
+            auto& s = self(context);
             return s.read(ptr, size, maxnum);
         };
 
         _rwops.write = [](SDL_RWops* context, const void* ptr, std::size_t size, std::size_t num) -> std::size_t {
-            auto& s = *reinterpret_cast<stream*>(context);
+            auto& s = self(context);
             return s.write(ptr, size, num);
         };
 
         _rwops.close = [](SDL_RWops* context) -> int {
-            auto& s = *reinterpret_cast<stream*>(context);
+            auto& s = self(context);
             return s.close();
         };
     }
@@ -59,6 +65,11 @@ public:
     }
 
 private:
+    static auto self(SDL_RWops* context) noexcept -> stream&
+    {
+        return *static_cast<stream*>(context->hidden.unknown.data1);
+    }
+
     SDL_RWops _rwops = {};
 };
 
@@ -67,13 +78,27 @@ public:
     file_stream(const char* file, const char* mode)
         : _file_stream{SDL_RWFromFile(file, mode)}
     {
-        if (!_file_stream) throw error{};
+        if (!_file_stream) SDLW_DETAIL_THROW_ERROR();
     }
 
     file_stream(FILE* fp, bool autoclose)
         : _file_stream{SDL_RWFromFP(fp, static_cast<SDL_bool>(autoclose))}
     {
-        if (!_file_stream) throw error{};
+        if (!_file_stream) SDLW_DETAIL_THROW_ERROR();
+    }
+
+    // Non-throwing open; check the stream with operator bool before use.
+    file_stream(const char* file, const char* mode, std::nothrow_t) noexcept
+        : _file_stream{SDL_RWFromFile(file, mode)}
+    {}
+
+    file_stream(FILE* fp, bool autoclose, std::nothrow_t) noexcept
+        : _file_stream{SDL_RWFromFP(fp, static_cast<SDL_bool>(autoclose))}
+    {}
+
+    explicit operator bool() const noexcept
+    {
+        return _file_stream != nullptr;
     }
 
     auto size() const -> i64 override
@@ -110,13 +135,27 @@ public:
     memory_stream(const void* mem, int size)
         : _memory_stream(SDL_RWFromConstMem(mem, size))
     {
-        if (!_memory_stream) throw error{};
+        if (!_memory_stream) SDLW_DETAIL_THROW_ERROR();
     }
 
     memory_stream(void* mem, int size)
         : _memory_stream(SDL_RWFromMem(mem, size))
     {
-        if (!_memory_stream) throw error{};
+        if (!_memory_stream) SDLW_DETAIL_THROW_ERROR();
+    }
+
+    // Non-throwing open; check the stream with operator bool before use.
+    memory_stream(const void* mem, int size, std::nothrow_t) noexcept
+        : _memory_stream(SDL_RWFromConstMem(mem, size))
+    {}
+
+    memory_stream(void* mem, int size, std::nothrow_t) noexcept
+        : _memory_stream(SDL_RWFromMem(mem, size))
+    {}
+
+    explicit operator bool() const noexcept
+    {
+        return _memory_stream != nullptr;
     }
 
     auto size() const -> i64 override
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <sdlw/assert.hpp>
+#include <sdlw/atlas.hpp>
 #include <sdlw/audio.hpp>
 #include <sdlw/blend_mode.hpp>
 #include <sdlw/clipboard.hpp>
+#include <sdlw/command_buffer.hpp>
+#include <sdlw/compositor.hpp>
 #include <sdlw/cpu_info.hpp>
+#include <sdlw/damage_tracker.hpp>
 #include <sdlw/error.hpp>
 #include <sdlw/events.hpp>
 #include <sdlw/filesystem.hpp>
 #include <sdlw/game_controller.hpp>
+#include <sdlw/geometry_batch.hpp>
 #include <sdlw/gesture.hpp>
 #include <sdlw/hints.hpp>
 #include <sdlw/joystick.hpp>
@@ -17,18 +22,31 @@
 #include <sdlw/loadso.hpp>
 #include <sdlw/log.hpp>
 #include <sdlw/message_box.hpp>
+#include <sdlw/mipmap.hpp>
 #include <sdlw/mouse.hpp>
+#include <sdlw/parallel_blit.hpp>
+#include <sdlw/parallel_draw_list.hpp>
+#include <sdlw/pixel_view.hpp>
 #include <sdlw/pixels.hpp>
 #include <sdlw/platform.hpp>
 #include <sdlw/power.hpp>
 #include <sdlw/rect.hpp>
 #include <sdlw/render.hpp>
+#include <sdlw/render_state_cache.hpp>
+#include <sdlw/render_target_pool.hpp>
+#include <sdlw/resample.hpp>
 #include <sdlw/rwops.hpp>
 #include <sdlw/scancode.hpp>
+#include <sdlw/spatial_grid.hpp>
+#include <sdlw/sprite_batch.hpp>
+#include <sdlw/streaming_texture.hpp>
 #include <sdlw/subsystem.hpp>
 #include <sdlw/surface.hpp>
+#include <sdlw/texture_uploader.hpp>
+#include <sdlw/tilemap.hpp>
 #include <sdlw/timer.hpp>
 #include <sdlw/touch.hpp>
 #include <sdlw/types.hpp>
 #include <sdlw/version.hpp>
 #include <sdlw/video.hpp>
+#include <sdlw/worker_pool.hpp>
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include <sdlw/assert.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/types.hpp>
+
+namespace sdl {
+
+// Uniform grid over rect bounds for culling and picking. Each entry is
+// listed in every cell its bounds touch; cells live in a hash map, so the
+// covered area is unbounded and only occupied cells cost memory. Pick a
+// cell size near the typical entry size. Rects are half-open, as in
+// SDL_HasIntersection: empty bounds are stored but never found. Queries
+// are const and may run concurrently with each other.
+class spatial_grid {
+public:
+    using id = u32;
+
+    explicit spatial_grid(int cell_size = 64) noexcept
+        : _cell_size{std::max(cell_size, 1)}
+    {}
+
+    auto insert(const rect& bounds) -> id
+    {
+        auto i = id{};
+        if (_free.empty()) {
+            i = static_cast<id>(_entries.size());
+            _entries.push_back(entry{bounds, true});
+        } else {
+            i = _free.back();
+            _free.pop_back();
+            _entries[i] = entry{bounds, true};
+        }
+        link(i, bounds);
+        ++_size;
+        return i;
+    }
+
+    // Inserts every rect and stores the new ids in ids, which must be at
+    // least as long as bounds.
+    void insert(span<const rect> bounds, span<id> ids)
+    {
+        SDL_ASSERT(ids.size() >= bounds.size());
+        _entries.reserve(_entries.size() + static_cast<std::size_t>(bounds.size()));
+        for (auto i = decltype(bounds.size()){0}; i < bounds.size(); ++i) {
+            ids[i] = insert(bounds[i]);
+        }
+    }
+
+    // Replaces the contents; entry i gets id i.
+    void assign(span<const rect> bounds)
+    {
+        clear();
+        _entries.reserve(static_cast<std::size_t>(bounds.size()));
+        for (const auto& b : bounds) {
+            insert(b);
+        }
+    }
+
+    // Moves an entry. Cells are only touched when the covered cell range
+    // changes, which makes small moves cheap.
+    void update(id i, const rect& bounds)
+    {
+        auto& e = _entries[i];
+        SDL_ASSERT(e.alive);
+        if (cells_of(e.bounds) != cells_of(bounds)) {
+            unlink(i, e.bounds);
+            link(i, bounds);
+        }
+        e.bounds = bounds;
+    }
+
+    void erase(id i)
+    {
+        auto& e = _entries[i];
+        SDL_ASSERT(e.alive);
+        unlink(i, e.bounds);
+        e.alive = false;
+        _free.push_back(i);
+        --_size;
+    }
+
+    void clear() noexcept
+    {
+        _cells.clear();
+        _entries.clear();
+        _free.clear();
+        _size = 0;
+    }
+
+    auto bounds(id i) const noexcept -> const rect&
+    {
+        return _entries[i].bounds;
+    }
+
+    auto contains(id i) const noexcept -> bool
+    {
+        return i < _entries.size() && _entries[i].alive;
+    }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return _size;
+    }
+
+    auto cell_size() const noexcept -> int
+    {
+        return _cell_size;
+    }
+
+    // Writes the ids of entries intersecting area to out, each once, in no
+    // particular order. Returns the total number of hits, which may exceed
+    // out.size(); only the first out.size() are written.
+    auto query(const rect& area, span<id> out) const -> std::size_t
+    {
+        if (area.w <= 0 || area.h <= 0) return 0;
+        auto count = std::size_t{0};
+        const auto cells = cells_of(area);
+        for (auto cy = cells.y0; cy <= cells.y1; ++cy) {
+            for (auto cx = cells.x0; cx <= cells.x1; ++cx) {
+                const auto it = _cells.find(key(cx, cy));
+                if (it == _cells.end()) continue;
+                for (const auto i : it->second) {
+                    const auto o = detail::overlap(area, _entries[i].bounds);
+                    if (o.w <= 0 || o.h <= 0) continue;
+                    // An entry spanning several cells is reported only from
+                    // the cell holding the top-left corner of the overlap.
+                    if (cell(o.x) != cx || cell(o.y) != cy) continue;
+                    if (count < static_cast<std::size_t>(out.size())) {
+                        out[static_cast<decltype(out.size())>(count)] = i;
+                    }
+                    ++count;
+                }
+            }
+        }
+        return count;
+    }
+
+    // Same as above for the entries containing p.
+    auto query(const point& p, span<id> out) const -> std::size_t
+    {
+        const auto it = _cells.find(key(cell(p.x), cell(p.y)));
+        if (it == _cells.end()) return 0;
+        auto count = std::size_t{0};
+        for (const auto i : it->second) {
+            const auto& b = _entries[i].bounds;
+            if (p.x < b.x || p.y < b.y || p.x >= b.x + b.w || p.y >= b.y + b.h) continue;
+            if (count < static_cast<std::size_t>(out.size())) {
+                out[static_cast<decltype(out.size())>(count)] = i;
+            }
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    struct entry {
+        rect bounds;
+        bool alive;
+    };
+
+    struct cell_range {
+        int x0, y0, x1, y1;
+
+        auto operator!=(const cell_range& other) const noexcept -> bool
+        {
+            return x0 != other.x0 || y0 != other.y0 || x1 != other.x1 || y1 != other.y1;
+        }
+    };
+
+    static auto key(int cx, int cy) noexcept -> u64
+    {
+        return static_cast<u64>(static_cast<u32>(cx)) << 32 | static_cast<u32>(cy);
+    }
+
+    auto cell(int v) const noexcept -> int
+    {
+        return v / _cell_size - (v % _cell_size != 0 && v < 0);
+    }
+
+    // Empty bounds cover no cells: x1 < x0.
+    auto cells_of(const rect& r) const noexcept -> cell_range
+    {
+        if (r.w <= 0 || r.h <= 0) return {0, 0, -1, -1};
+        return {cell(r.x), cell(r.y), cell(r.x + r.w - 1), cell(r.y + r.h - 1)};
+    }
+
+    void link(id i, const rect& bounds)
+    {
+        const auto cells = cells_of(bounds);
+        for (auto cy = cells.y0; cy <= cells.y1; ++cy) {
+            for (auto cx = cells.x0; cx <= cells.x1; ++cx) {
+                _cells[key(cx, cy)].push_back(i);
+            }
+        }
+    }
+
+    void unlink(id i, const rect& bounds)
+    {
+        const auto cells = cells_of(bounds);
+        for (auto cy = cells.y0; cy <= cells.y1; ++cy) {
+            for (auto cx = cells.x0; cx <= cells.x1; ++cx) {
+                const auto cell_it = _cells.find(key(cx, cy));
+                SDL_ASSERT(cell_it != _cells.end());
+                auto& ids = cell_it->second;
+                const auto it = std::find(ids.begin(), ids.end(), i);
+                SDL_ASSERT(it != ids.end());
+                *it = ids.back();
+                ids.pop_back();
+                if (ids.empty()) _cells.erase(cell_it);
+            }
+        }
+    }
+
+    int _cell_size;
+    std::unordered_map<u64, std::vector<id>> _cells;
+    std::vector<entry> _entries;
+    std::vector<id> _free;
+    std::size_t _size = 0;
+};
+
+} // namespace sdl
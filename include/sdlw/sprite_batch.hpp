@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <SDL2/SDL_render.h>
+#include <SDL2/SDL_version.h>
+
+#include <sdlw/blend_mode.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#    define SDLW_DETAIL_HAS_RENDER_GEOMETRY 1
+#else
+#    define SDLW_DETAIL_HAS_RENDER_GEOMETRY 0
+#endif
+
+namespace sdl {
+
+// Collects textured quads and submits them with one geometry call per run of
+// equal (texture, blend mode) state. Queued textures must outlive flush(),
+// which puts back the blend mode and color and alpha mods it changed on
+// them. sort_mode::texture merges more runs but gives up painter's order
+// between textures, and the order it picks follows texture addresses, so
+// only use it when sprites of different textures never overlap.
+class sprite_batch {
+public:
+    enum class sort_mode {
+        none,   // keep submission order, merge adjacent sprites only
+        texture // stable sort by texture and blend mode before submitting
+    };
+
+    static constexpr auto white = color{255, 255, 255, 255};
+
+    explicit sprite_batch(renderer& r, sort_mode mode = sort_mode::none) noexcept
+        : _renderer{r}
+        , _sort_mode{mode}
+    {}
+
+    sprite_batch(const sprite_batch&) = delete;
+    auto operator=(const sprite_batch&) -> sprite_batch& = delete;
+
+    void reserve(std::size_t sprite_count)
+    {
+        _sprites.reserve(sprite_count);
+        _vertices.reserve(sprite_count * 4);
+    }
+
+    void draw(const texture_ref& t, const rect* src, const rect& dst, color mod = white, blend_mode mode = blend_mode::blend)
+    {
+        draw(t, src, dst, 0.0, nullptr, renderer_flip::none, mod, mode);
+    }
+
+    void draw(const sub_texture& st, const rect& dst, color mod = white, blend_mode mode = blend_mode::blend)
+    {
+        draw(*st.texture, &st.area, dst, mod, mode);
+    }
+
+    void draw(
+        const texture_ref& t,
+        const rect* src,
+        const rect& dst,
+        double angle,
+        const point* center,
+        renderer_flip flip,
+        color mod = white,
+        blend_mode mode = blend_mode::blend)
+    {
+        auto s = sprite{};
+        s.texture = t;
+        s.mode = mode;
+        s.has_src = src != nullptr;
+        s.src = src ? *src : rect{};
+        s.dst = dst;
+        s.angle = angle;
+        s.has_center = center != nullptr;
+        s.center = center ? *center : point{};
+        s.flip = flip;
+        s.mod = mod;
+        _sprites.push_back(s);
+    }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return _sprites.size();
+    }
+
+    auto empty() const noexcept -> bool
+    {
+        return _sprites.empty();
+    }
+
+    // Number of SDL draw calls issued by the last flush().
+    auto draw_calls() const noexcept -> int
+    {
+        return _draw_calls;
+    }
+
+    void clear() noexcept
+    {
+        _sprites.clear();
+    }
+
+    void flush()
+    {
+        _draw_calls = 0;
+        if (_sprites.empty()) {
+            return;
+        }
+        if (_sort_mode == sort_mode::texture) {
+            std::stable_sort(_sprites.begin(), _sprites.end(), [](const sprite& lhs, const sprite& rhs) {
+                if (lhs.texture != rhs.texture) return lhs.texture.get_pointer() < rhs.texture.get_pointer();
+                return lhs.mode < rhs.mode;
+            });
+        }
+        // Restores texture state even when a draw call throws.
+        struct restore_guard {
+            sprite_batch& batch;
+            ~restore_guard() { batch.restore_textures(); }
+        } guard{*this};
+#if SDLW_DETAIL_HAS_RENDER_GEOMETRY
+        submit_geometry();
+#else
+        submit_copies();
+#endif
+        _sprites.clear();
+    }
+
+private:
+    struct sprite {
+        texture_ref texture;
+        blend_mode mode;
+        bool has_src;
+        bool has_center;
+        rect src;
+        rect dst;
+        double angle;
+        point center;
+        renderer_flip flip;
+        color mod;
+    };
+
+    static auto same_state(const sprite& lhs, const sprite& rhs) noexcept -> bool
+    {
+        return lhs.texture == rhs.texture && lhs.mode == rhs.mode;
+    }
+
+    struct texture_state {
+        SDL_Texture* texture;
+        SDL_BlendMode mode;
+        u8 r;
+        u8 g;
+        u8 b;
+        u8 a;
+    };
+
+    // Remembers a texture's state the first time flush() touches it.
+    void save_texture(SDL_Texture* t)
+    {
+        const auto saved = std::any_of(_saved.begin(), _saved.end(), [t](const texture_state& s) { return s.texture == t; });
+        if (saved) return;
+        auto s = texture_state{t, SDL_BLENDMODE_NONE, 255, 255, 255, 255};
+        SDL_GetTextureBlendMode(t, &s.mode);
+        SDL_GetTextureColorMod(t, &s.r, &s.g, &s.b);
+        SDL_GetTextureAlphaMod(t, &s.a);
+        _saved.push_back(s);
+    }
+
+    void restore_textures() noexcept
+    {
+        for (const auto& s : _saved) {
+            SDL_SetTextureBlendMode(s.texture, s.mode);
+            SDL_SetTextureColorMod(s.texture, s.r, s.g, s.b);
+            SDL_SetTextureAlphaMod(s.texture, s.a);
+        }
+        _saved.clear();
+    }
+
+    void apply_blend_mode(SDL_Texture* t, blend_mode mode)
+    {
+        save_texture(t);
+        if (SDL_SetTextureBlendMode(t, static_cast<SDL_BlendMode>(mode)) < 0) {
+            SDLW_DETAIL_THROW_ERROR();
+        }
+    }
+
+#if SDLW_DETAIL_HAS_RENDER_GEOMETRY
+    void ensure_indices(std::size_t quad_count)
+    {
+        const auto old_quads = _indices.size() / 6;
+        if (old_quads >= quad_count) {
+            return;
+        }
+        _indices.resize(quad_count * 6);
+        for (auto q = old_quads; q < quad_count; ++q) {
+            const auto base = static_cast<int>(q * 4);
+            const auto i = _indices.data() + q * 6;
+            i[0] = base;
+            i[1] = base + 1;
+            i[2] = base + 2;
+            i[3] = base + 2;
+            i[4] = base + 3;
+            i[5] = base;
+        }
+    }
+
+    void append_quad(const sprite& s, float inv_w, float inv_h, const sdl::size& tex_size)
+    {
+        const auto src = s.has_src ? s.src : rect{0, 0, tex_size.w, tex_size.h};
+        auto u0 = src.x * inv_w;
+        auto v0 = src.y * inv_h;
+        auto u1 = (src.x + src.w) * inv_w;
+        auto v1 = (src.y + src.h) * inv_h;
+        if (static_cast<bool>(s.flip & renderer_flip::horizontal)) std::swap(u0, u1);
+        if (static_cast<bool>(s.flip & renderer_flip::vertical)) std::swap(v0, v1);
+
+        const auto x0 = static_cast<float>(s.dst.x);
+        const auto y0 = static_cast<float>(s.dst.y);
+        const auto x1 = static_cast<float>(s.dst.x + s.dst.w);
+        const auto y1 = static_cast<float>(s.dst.y + s.dst.h);
+        SDL_FPoint corners[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+
+        if (s.angle != 0.0) {
+            const auto cx = x0 + (s.has_center ? s.center.x : s.dst.w / 2.0f);
+            const auto cy = y0 + (s.has_center ? s.center.y : s.dst.h / 2.0f);
+            const auto radians = s.angle * (3.14159265358979323846 / 180.0);
+            const auto c = static_cast<float>(std::cos(radians));
+            const auto sn = static_cast<float>(std::sin(radians));
+            for (auto& p : corners) {
+                const auto dx = p.x - cx;
+                const auto dy = p.y - cy;
+                p = {cx + dx * c - dy * sn, cy + dx * sn + dy * c};
+            }
+        }
+
+        const SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+        for (auto i = 0; i < 4; ++i) {
+            _vertices.push_back(SDL_Vertex{corners[i], s.mod, uvs[i]});
+        }
+    }
+
+    void submit_geometry()
+    {
+        ensure_indices(_sprites.size());
+        _vertices.clear();
+        const auto prend = _renderer.get_pointer();
+        auto first = std::size_t{0};
+        while (first != _sprites.size()) {
+            auto last = first + 1;
+            while (last != _sprites.size() && same_state(_sprites[first], _sprites[last])) ++last;
+
+            const auto ptex = _sprites[first].texture.get_pointer();
+            const auto tex_size = _sprites[first].texture.size();
+            const auto inv_w = 1.0f / static_cast<float>(tex_size.w);
+            const auto inv_h = 1.0f / static_cast<float>(tex_size.h);
+            const auto vertex_offset = _vertices.size();
+            for (auto i = first; i != last; ++i) {
+                append_quad(_sprites[i], inv_w, inv_h, tex_size);
+            }
+
+            apply_blend_mode(ptex, _sprites[first].mode);
+            const auto vertices = _vertices.data() + vertex_offset;
+            const auto num_vertices = static_cast<int>((last - first) * 4);
+            const auto num_indices = static_cast<int>((last - first) * 6);
+            if (SDL_RenderGeometry(prend, ptex, vertices, num_vertices, _indices.data(), num_indices) < 0) {
+                SDLW_DETAIL_THROW_ERROR();
+            }
+            ++_draw_calls;
+            first = last;
+        }
+    }
+#endif
+
+    // Fallback for SDL versions without SDL_RenderGeometry: one copy per
+    // sprite, but texture state is only touched when it actually changes.
+    void submit_copies()
+    {
+        auto current = static_cast<const sprite*>(nullptr);
+        for (const auto& s : _sprites) {
+            auto t = s.texture;
+            if (!current || !same_state(*current, s)) {
+                apply_blend_mode(t.get_pointer(), s.mode);
+            }
+            if (!current || current->texture != s.texture || current->mod != s.mod) {
+                t.set_color_mod(s.mod.r, s.mod.g, s.mod.b);
+                t.set_alpha_mod(s.mod.a);
+            }
+            const auto src = s.has_src ? &s.src : nullptr;
+            if (s.angle == 0.0 && s.flip == renderer_flip::none) {
+                _renderer.copy(t, src, &s.dst);
+            } else {
+                _renderer.copy(t, src, &s.dst, s.angle, s.has_center ? &s.center : nullptr, s.flip);
+            }
+            ++_draw_calls;
+            current = &s;
+        }
+    }
+
+    renderer& _renderer;
+    sort_mode _sort_mode;
+    std::vector<sprite> _sprites;
+    std::vector<SDL_Vertex> _vertices;
+    std::vector<int> _indices;
+    std::vector<texture_state> _saved;
+    int _draw_calls = 0;
+};
+
+} // namespace sdl
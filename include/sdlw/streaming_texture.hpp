@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sdlw/assert.hpp>
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+
+namespace sdl {
+
+class streaming_texture;
+
+// Write access to one locked buffer of a streaming_texture. Rows are pitch()
+// bytes apart, which may be more than size().w pixels. Destroying or
+// unlock()ing the guard unlocks the texture and publishes it as the new
+// front buffer.
+template<typename Pixel>
+class streaming_lock {
+public:
+    streaming_lock(const streaming_lock&) = delete;
+    auto operator=(const streaming_lock&) -> streaming_lock& = delete;
+
+    streaming_lock(streaming_lock&& other) noexcept
+        : _owner{std::exchange(other._owner, nullptr)}
+        , _index{other._index}
+        , _pixels{other._pixels}
+        , _pitch{other._pitch}
+        , _size{other._size}
+    {}
+
+    auto operator=(streaming_lock&&) -> streaming_lock& = delete;
+
+    ~streaming_lock()
+    {
+        unlock();
+    }
+
+    // Every locked pixel, row padding included.
+    auto pixels() const noexcept -> span<Pixel>
+    {
+        const auto count = _size.h > 0 ? stride() * (_size.h - 1) + _size.w : 0;
+        return span<Pixel>(_pixels, count);
+    }
+
+    auto row(int y) const noexcept -> span<Pixel>
+    {
+        return span<Pixel>(_pixels + static_cast<std::ptrdiff_t>(y) * stride(), _size.w);
+    }
+
+    // Distance between rows in bytes.
+    auto pitch() const noexcept -> int
+    {
+        return _pitch;
+    }
+
+    // Distance between rows in pixels.
+    auto stride() const noexcept -> int
+    {
+        return _pitch / static_cast<int>(sizeof(Pixel));
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _size;
+    }
+
+    void unlock() noexcept;
+
+private:
+    friend class streaming_texture;
+
+    streaming_lock(streaming_texture* owner, int index, void* pixels, int pitch, const sdl::size& sz) noexcept
+        : _owner{owner}
+        , _index{index}
+        , _pixels{static_cast<Pixel*>(pixels)}
+        , _pitch{pitch}
+        , _size{sz}
+    {}
+
+    streaming_texture* _owner;
+    int _index;
+    Pixel* _pixels;
+    int _pitch;
+    sdl::size _size;
+};
+
+// Rotates through buffer_count streaming textures so a producer fills one
+// while the most recently completed one is being drawn. Use 2 buffers when
+// the renderer draws front() right after each upload, 3 when the GPU may
+// still be sampling the previous frame. Locking happens on the render
+// thread; the locked memory itself may be filled from any thread.
+class streaming_texture {
+public:
+    streaming_texture(renderer& r, pixel_format_type format, const sdl::size& sz, int buffer_count = 2)
+        : _size{sz}
+        , _format{format}
+    {
+        _textures.reserve(static_cast<std::size_t>(std::max(buffer_count, 1)));
+        for (auto i = 0; i < std::max(buffer_count, 1); ++i) {
+            _textures.emplace_back(r, format, texture_access::streaming, sz);
+        }
+    }
+
+    streaming_texture(const streaming_texture&) = delete;
+    auto operator=(const streaming_texture&) -> streaming_texture& = delete;
+
+    // Locks the buffer after the current front. Only one lock may be held
+    // at a time. Pixel must match the format's bytes per pixel (u8 for
+    // planar YUV formats).
+    template<typename Pixel = u32>
+    auto lock() -> streaming_lock<Pixel>
+    {
+        SDL_ASSERT(is_fourcc(_format) || sizeof(Pixel) == static_cast<std::size_t>(bytes_per_pixel(_format)));
+        if (_locked >= 0) {
+            set_error("sdl::streaming_texture: a buffer is already locked");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        const auto index = (_front + 1) % static_cast<int>(_textures.size());
+        const auto [pixels, pitch] = _textures[static_cast<std::size_t>(index)].lock(rect{0, 0, _size.w, _size.h});
+        _locked = index;
+        return streaming_lock<Pixel>{this, index, pixels, pitch, _size};
+    }
+
+    // The most recently published buffer. Its contents are undefined until
+    // the first lock has been released.
+    auto front() const noexcept -> const texture&
+    {
+        return _textures[static_cast<std::size_t>(_front)];
+    }
+
+    auto has_frame() const noexcept -> bool
+    {
+        return _published > 0;
+    }
+
+    auto frames_published() const noexcept -> u64
+    {
+        return _published;
+    }
+
+    auto buffer_count() const noexcept -> int
+    {
+        return static_cast<int>(_textures.size());
+    }
+
+    auto size() const noexcept -> sdl::size
+    {
+        return _size;
+    }
+
+    auto format() const noexcept -> pixel_format_type
+    {
+        return _format;
+    }
+
+private:
+    template<typename Pixel>
+    friend class streaming_lock;
+
+    void publish(int index) noexcept
+    {
+        _textures[static_cast<std::size_t>(index)].unlock();
+        _front = index;
+        _locked = -1;
+        ++_published;
+    }
+
+    std::vector<texture> _textures;
+    sdl::size _size;
+    pixel_format_type _format;
+    int _front = 0;
+    int _locked = -1;
+    u64 _published = 0;
+};
+
+template<typename Pixel>
+inline void streaming_lock<Pixel>::unlock() noexcept
+{
+    if (_owner) {
+        _owner->publish(_index);
+        _owner = nullptr;
+    }
+}
+
+} // namespace sdl
@@ -31,7 +31,7 @@ public:
         : _flags(static_cast<u32>(flags))
     {
         if (SDL_InitSubSystem(_flags) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
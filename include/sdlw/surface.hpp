@@ -1,12 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <new>
 
 #include <SDL2/SDL_surface.h>
 
 #include <sdlw/blend_mode.hpp>
 #include <sdlw/rwops.hpp>
 
+#include "sdlw/detail/pixel_convert.hpp"
 #include "sdlw/detail/utility.hpp"
 
 namespace sdl {
@@ -20,25 +22,25 @@ public:
     surface(int width, int height, int depth, u32 rmask, u32 gmask, u32 bmask, u32 amask)
         : surface{SDL_CreateRGBSurface(0, width, height, depth, rmask, gmask, bmask, amask)}
     {
-        if (!_surface) throw error{};
+        if (!_surface) SDLW_DETAIL_THROW_ERROR();
     }
 
     surface(void* pixels, int width, int height, int depth, int pitch, u32 rmask, u32 gmask, u32 bmask, u32 amask)
         : surface{SDL_CreateRGBSurfaceFrom(pixels, width, height, depth, pitch, rmask, gmask, bmask, amask)}
     {
-        if (!_surface) throw error{};
+        if (!_surface) SDLW_DETAIL_THROW_ERROR();
     }
 
     surface(int width, int height, int depth, pixel_format_type format)
         : surface{SDL_CreateRGBSurfaceWithFormat(0, width, height, depth, static_cast<u32>(format))}
     {
-        if (!_surface) throw error{};
+        if (!_surface) SDLW_DETAIL_THROW_ERROR();
     }
 
     surface(void* pixels, int width, int height, int depth, int pitch, pixel_format_type format)
         : surface{SDL_CreateRGBSurfaceWithFormatFrom(pixels, width, height, depth, pitch, static_cast<u32>(format))}
     {
-        if (!_surface) throw error{};
+        if (!_surface) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto format() const noexcept -> pixel_format_ref
@@ -56,22 +58,39 @@ public:
         return _surface->pitch;
     }
 
+    auto pixels() const noexcept -> void*
+    {
+        return _surface->pixels;
+    }
+
     void fill(const rect& r, u32 color)
     {
         if (SDL_FillRect(_surface.get(), &r, color) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto fill(const rect& r, u32 color, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_FillRect(_surface.get(), &r, color));
+    }
+
     void fill(span<const rect> rects, u32 color)
     {
         if (SDL_FillRects(_surface.get(), rects.data(), static_cast<int>(rects.size()), color) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto fill(span<const rect> rects, u32 color, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_FillRects(_surface.get(), rects.data(), static_cast<int>(rects.size()), color));
+    }
+
     auto convert(pixel_format_ref fmt) const -> surface;
 
+    auto convert(pixel_format_ref fmt, std::nothrow_t) const noexcept -> expected<surface>;
+
     auto clip() const noexcept -> rect
     {
         auto r = rect{};
@@ -83,7 +102,7 @@ public:
     {
         auto key = u32{};
         if (SDL_GetColorKey(_surface.get(), &key) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return key;
         }
@@ -93,7 +112,7 @@ public:
     {
         auto alpha = u8{};
         if (SDL_GetSurfaceAlphaMod(_surface.get(), &alpha) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return alpha;
         }
@@ -103,7 +122,7 @@ public:
     {
         auto bm = SDL_BlendMode{};
         if (SDL_GetSurfaceBlendMode(_surface.get(), &bm) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return static_cast<sdl::blend_mode>(bm);
         }
@@ -115,7 +134,7 @@ public:
         auto g = u8{};
         auto b = u8{};
         if (SDL_GetSurfaceColorMod(_surface.get(), &r, &g, &b) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return {r, g, b};
         }
@@ -124,10 +143,15 @@ public:
     void lock()
     {
         if (SDL_LockSurface(_surface.get()) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto lock(std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_LockSurface(_surface.get()));
+    }
+
     auto must_lock() const noexcept -> bool
     {
         return static_cast<bool>(SDL_MUSTLOCK(_surface.get()));
@@ -141,42 +165,62 @@ public:
     void set_color_key(bool flag, u32 key)
     {
         if (SDL_SetColorKey(_surface.get(), static_cast<int>(flag), key) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_color_key(bool flag, u32 key, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetColorKey(_surface.get(), static_cast<int>(flag), key));
+    }
+
     void set_alpha_mod(u8 alpha)
     {
         if (SDL_SetSurfaceAlphaMod(_surface.get(), alpha) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_alpha_mod(u8 alpha, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetSurfaceAlphaMod(_surface.get(), alpha));
+    }
+
     void set_blend_mode(sdl::blend_mode bm)
     {
         if (SDL_SetSurfaceBlendMode(_surface.get(), static_cast<SDL_BlendMode>(bm)) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_blend_mode(sdl::blend_mode bm, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetSurfaceBlendMode(_surface.get(), static_cast<SDL_BlendMode>(bm)));
+    }
+
     void set_color_mod(u8 r, u8 g, u8 b)
     {
         if (SDL_SetSurfaceColorMod(_surface.get(), r, g, b) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
+    auto set_color_mod(u8 r, u8 g, u8 b, std::nothrow_t) noexcept -> status
+    {
+        return detail::make_status(SDL_SetSurfaceColorMod(_surface.get(), r, g, b));
+    }
+
     void set_palette(palette_ref p)
     {
         if (SDL_SetSurfacePalette(_surface.get(), p.get_pointer()) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
     void set_rle(bool flag)
     {
         if (SDL_SetSurfaceRLE(_surface.get(), static_cast<int>(flag)) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -194,7 +238,16 @@ inline auto surface::convert(pixel_format_ref fmt) const -> surface
     if (const auto s = SDL_ConvertSurface(_surface.get(), fmt.get_pointer(), 0)) {
         return surface{s};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto surface::convert(pixel_format_ref fmt, std::nothrow_t) const noexcept -> expected<surface>
+{
+    if (const auto s = SDL_ConvertSurface(_surface.get(), fmt.get_pointer(), 0)) {
+        return surface{s};
+    } else {
+        return unexpected{error_code{}};
     }
 }
 
@@ -218,45 +271,77 @@ public:
 inline void blit_scaled(const surface& src, surface& dst)
 {
     if (SDL_BlitScaled(src.get_pointer(), nullptr, dst.get_pointer(), nullptr) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto blit_scaled(const surface& src, surface& dst, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_BlitScaled(src.get_pointer(), nullptr, dst.get_pointer(), nullptr));
+}
+
 inline void blit_scaled(const surface& src, const rect& srcrect, surface& dst)
 {
     if (SDL_BlitScaled(src.get_pointer(), &srcrect, dst.get_pointer(), nullptr) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto blit_scaled(const surface& src, const rect& srcrect, surface& dst, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_BlitScaled(src.get_pointer(), &srcrect, dst.get_pointer(), nullptr));
+}
+
 inline void blit_scaled(const surface& src, surface& dst, rect& dstrect)
 {
     if (SDL_BlitScaled(src.get_pointer(), nullptr, dst.get_pointer(), &dstrect) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto blit_scaled(const surface& src, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_BlitScaled(src.get_pointer(), nullptr, dst.get_pointer(), &dstrect));
+}
+
 inline void blit_scaled(const surface& src, const rect& srcrect, surface& dst, rect& dstrect)
 {
     if (SDL_BlitScaled(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto blit_scaled(const surface& src, const rect& srcrect, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_BlitScaled(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect));
+}
+
 inline void blit(const surface& src, surface& dst, rect& dstrect)
 {
     if (SDL_BlitSurface(src.get_pointer(), nullptr, dst.get_pointer(), &dstrect) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto blit(const surface& src, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_BlitSurface(src.get_pointer(), nullptr, dst.get_pointer(), &dstrect));
+}
+
 inline void blit(const surface& src, const rect& srcrect, surface& dst, rect& dstrect)
 {
     if (SDL_BlitSurface(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto blit(const surface& src, const rect& srcrect, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_BlitSurface(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect));
+}
+
+// The common 8888, 24-bit and 565 pairs use vector kernels when the CPU
+// has SSSE3; everything else goes through SDL_ConvertPixels.
 inline void convert_pixels(
     int width,
     int height,
@@ -267,19 +352,57 @@ inline void convert_pixels(
     void* dst,
     int dst_pitch)
 {
+    if (detail::convert_pixels_simd(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch)) return;
     const auto srcfmt = static_cast<u32>(src_format);
     const auto dstfmt = static_cast<u32>(dst_format);
     if (SDL_ConvertPixels(width, height, srcfmt, src, src_pitch, dstfmt, dst, dst_pitch) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto convert_pixels(
+    int width,
+    int height,
+    pixel_format_type src_format,
+    const void* src,
+    int src_pitch,
+    pixel_format_type dst_format,
+    void* dst,
+    int dst_pitch,
+    std::nothrow_t) noexcept -> status
+{
+    if (detail::convert_pixels_simd(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch)) return {};
+    const auto srcfmt = static_cast<u32>(src_format);
+    const auto dstfmt = static_cast<u32>(dst_format);
+    return detail::make_status(SDL_ConvertPixels(width, height, srcfmt, src, src_pitch, dstfmt, dst, dst_pitch));
+}
+
+// Copies s into a new ARGB8888 surface with RLE acceleration off, ready
+// for direct pixel access. SDL carries RLE over from the source, and an
+// RLE surface only exposes its pixels while locked.
+inline auto to_argb8888(const surface& s) -> surface
+{
+    const auto converted = SDL_ConvertSurfaceFormat(s.get_pointer(), static_cast<u32>(pixel_format_type::argb8888), 0);
+    if (!converted) SDLW_DETAIL_THROW_ERROR();
+    auto out = surface{converted};
+    out.set_rle(false);
+    return out;
+}
+
+inline auto to_argb8888(const surface& s, std::nothrow_t) noexcept -> expected<surface>
+{
+    const auto converted = SDL_ConvertSurfaceFormat(s.get_pointer(), static_cast<u32>(pixel_format_type::argb8888), 0);
+    if (!converted) return unexpected{error_code{}};
+    SDL_SetSurfaceRLE(converted, 0);
+    return surface{converted};
+}
+
 inline auto load_bmp(const char* file) -> surface
 {
     if (const auto ptr = SDL_LoadBMP(file)) {
         return surface{ptr};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -288,42 +411,57 @@ inline auto load_bmp(stream& s) -> surface
     if (const auto ptr = SDL_LoadBMP_RW(s.get_pointer(), 0)) {
         return surface{ptr};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
 inline auto lower_blit(const surface& src, surface& dst, rect& dstrect)
 {
     if (SDL_LowerBlit(src.get_pointer(), nullptr, dst.get_pointer(), &dstrect) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto lower_blit(const surface& src, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_LowerBlit(src.get_pointer(), nullptr, dst.get_pointer(), &dstrect));
+}
+
 inline auto lower_blit(const surface& src, rect& srcrect, surface& dst, rect& dstrect)
 {
     if (SDL_LowerBlit(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto lower_blit(const surface& src, rect& srcrect, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_LowerBlit(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect));
+}
+
 inline auto lower_blit_scaled(const surface& src, rect& srcrect, surface& dst, rect& dstrect)
 {
     if (SDL_LowerBlitScaled(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
+inline auto lower_blit_scaled(const surface& src, rect& srcrect, surface& dst, rect& dstrect, std::nothrow_t) noexcept -> status
+{
+    return detail::make_status(SDL_LowerBlitScaled(src.get_pointer(), &srcrect, dst.get_pointer(), &dstrect));
+}
+
 inline void save_bmp(const surface& s, const char* file)
 {
     if (SDL_SaveBMP(s.get_pointer(), file) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
 inline void save_bmp(const surface& surf, stream& s)
 {
     if (SDL_SaveBMP_RW(surf.get_pointer(), s.get_pointer(), 0) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/ttf.hpp>
+
+namespace sdl::ttf {
+
+// clang-format off
+
+enum class render_mode {
+    solid,
+    shaded,
+    blended
+};
+
+// clang-format on
+
+struct text_cache_stats {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 evictions = 0;
+    std::size_t resident_bytes = 0;
+    std::size_t entries = 0;
+};
+
+// Keeps rendered text as uploaded textures, keyed by (font, UTF-8 string,
+// colors, render mode, wrap length), evicting least recently used entries
+// once the byte budget is exceeded. wrap_length only applies to
+// render_mode::blended. An empty string yields an entry with a null texture
+// and a width of zero. References returned by get() stay valid until the
+// next call to get(), clear() or set_budget().
+class text_cache {
+public:
+    struct entry {
+        sdl::texture texture;
+        sdl::size size;
+    };
+
+    text_cache(renderer& r, std::size_t byte_budget)
+        : _renderer{r}
+        , _budget{byte_budget}
+    {}
+
+    text_cache(const text_cache&) = delete;
+    auto operator=(const text_cache&) -> text_cache& = delete;
+
+    auto get(const font& f, const char* utf8, color fg, render_mode mode = render_mode::blended, u32 wrap_length = 0, color bg = {})
+        -> const entry&
+    {
+        if (mode != render_mode::blended) wrap_length = 0;
+        if (mode != render_mode::shaded) bg = color{};
+        const auto text = std::string_view{utf8};
+        const auto h = hash(f, text, fg, bg, mode, wrap_length);
+
+        const auto [first, last] = _index.equal_range(h);
+        for (auto it = first; it != last; ++it) {
+            const auto node = it->second;
+            if (node->matches(f, text, fg, bg, mode, wrap_length)) {
+                _lru.splice(_lru.begin(), _lru, node);
+                ++_stats.hits;
+                return node->value;
+            }
+        }
+
+        ++_stats.misses;
+        if (text.empty()) {
+            // SDL_ttf refuses to render zero-width text, so an empty label
+            // gets no texture, only the font's line height.
+            const auto sz = sdl::size{0, f.height()};
+            _lru.push_front(node{f.get_pointer(), std::string{}, fg, bg, mode, wrap_length, h, 0, entry{sdl::texture{nullptr}, sz}});
+            _index.emplace(h, _lru.begin());
+            ++_stats.entries;
+            return _lru.front().value;
+        }
+        auto surf = render(f, utf8, fg, bg, mode, wrap_length);
+        auto tex = sdl::texture{_renderer, surf};
+        const auto sz = surf.size();
+        const auto bytes = static_cast<std::size_t>(sz.w) * sz.h * bytes_per_pixel(tex.format());
+        _lru.push_front(node{f.get_pointer(), std::string{text}, fg, bg, mode, wrap_length, h, bytes, entry{std::move(tex), sz}});
+        _index.emplace(h, _lru.begin());
+        _stats.resident_bytes += bytes;
+        ++_stats.entries;
+        trim(1);
+        return _lru.front().value;
+    }
+
+    auto stats() const noexcept -> const text_cache_stats&
+    {
+        return _stats;
+    }
+
+    void reset_counters() noexcept
+    {
+        _stats.hits = 0;
+        _stats.misses = 0;
+        _stats.evictions = 0;
+    }
+
+    auto budget() const noexcept -> std::size_t
+    {
+        return _budget;
+    }
+
+    void set_budget(std::size_t byte_budget)
+    {
+        _budget = byte_budget;
+        trim(0);
+    }
+
+    void clear() noexcept
+    {
+        _index.clear();
+        _lru.clear();
+        _stats.resident_bytes = 0;
+        _stats.entries = 0;
+    }
+
+private:
+    struct node {
+        TTF_Font* font;
+        std::string text;
+        color fg;
+        color bg;
+        render_mode mode;
+        u32 wrap_length;
+        std::size_t hash;
+        std::size_t bytes;
+        entry value;
+
+        auto matches(const ttf::font& f, std::string_view t, color fg_, color bg_, render_mode m, u32 wrap) const noexcept -> bool
+        {
+            return font == f.get_pointer() && mode == m && wrap_length == wrap && fg == fg_ && bg == bg_
+                && text == t;
+        }
+    };
+
+    using node_list = std::list<node>;
+
+    static auto pack(const color& c) noexcept -> u32
+    {
+        return (u32{c.r} << 24) | (u32{c.g} << 16) | (u32{c.b} << 8) | u32{c.a};
+    }
+
+    static auto hash(const font& f, std::string_view text, color fg, color bg, render_mode mode, u32 wrap) noexcept -> std::size_t
+    {
+        auto h = std::hash<std::string_view>{}(text);
+        const auto mix = [&h](std::size_t v) { h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2); };
+        mix(std::hash<const void*>{}(f.get_pointer()));
+        mix(pack(fg));
+        mix(pack(bg));
+        mix(static_cast<std::size_t>(mode));
+        mix(wrap);
+        return h;
+    }
+
+    static auto render(const font& f, const char* utf8, color fg, color bg, render_mode mode, u32 wrap) -> surface
+    {
+        switch (mode) {
+        case render_mode::solid: return solid_utf8_render(f, utf8, fg);
+        case render_mode::shaded: return shaded_utf8_render(f, utf8, fg, bg);
+        default: return wrap > 0 ? blended_wrapped_utf8_render(f, utf8, fg, wrap) : blended_utf8_render(f, utf8, fg);
+        }
+    }
+
+    // Evicts from the cold end while over budget, always keeping the `keep`
+    // most recently used entries.
+    void trim(std::size_t keep)
+    {
+        while (_stats.resident_bytes > _budget && _lru.size() > keep) {
+            const auto victim = std::prev(_lru.end());
+            const auto [first, last] = _index.equal_range(victim->hash);
+            for (auto it = first; it != last; ++it) {
+                if (it->second == victim) {
+                    _index.erase(it);
+                    break;
+                }
+            }
+            _stats.resident_bytes -= victim->bytes;
+            --_stats.entries;
+            ++_stats.evictions;
+            _lru.erase(victim);
+        }
+    }
+
+    renderer& _renderer;
+    std::size_t _budget;
+    node_list _lru;
+    std::unordered_multimap<std::size_t, node_list::iterator> _index;
+    text_cache_stats _stats;
+};
+
+} // namespace sdl::ttf
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <sdlw/error.hpp>
+#include <sdlw/image.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/rwops.hpp>
+
+namespace sdl {
+
+namespace detail {
+
+// Video memory taken by a texture, estimated as bytes_per_pixel * w * h.
+// Planar YUV formats report one byte per pixel, so their two quarter-size
+// chroma planes are added on top.
+inline auto texture_bytes(const texture_ref& t) noexcept -> std::size_t
+{
+    const auto sz = t.size();
+    const auto pixels = static_cast<std::size_t>(sz.w) * static_cast<std::size_t>(sz.h);
+    const auto format = t.format();
+    const auto bytes = static_cast<std::size_t>(bytes_per_pixel(format)) * pixels;
+    return is_fourcc(format) && bytes_per_pixel(format) == 1 ? bytes + pixels / 2 : bytes;
+}
+
+} // namespace detail
+
+struct texture_budget_stats {
+    std::size_t resident_bytes = 0;
+    std::size_t peak_bytes = 0;
+    std::size_t resident_count = 0;
+    u64 evictions = 0;
+    u64 loads = 0; // first loads and reloads after eviction
+    std::chrono::nanoseconds total_load_time{0};
+    std::chrono::nanoseconds max_load_time{0};
+};
+
+// Owns textures that can be recreated from their source and keeps the sum
+// of their sizes under a byte budget. get() loads a texture on demand and
+// marks it as drawn this frame; when the budget is exceeded, the textures
+// drawn least recently are destroyed. Textures drawn in the current frame
+// are never evicted, so the budget may be overshot until end_frame().
+// Texture state (blend mode, mods) is lost on eviction and must be set
+// again after each get().
+class texture_budget {
+public:
+    using id = std::size_t;
+    using generator = std::function<texture(const renderer&)>;
+
+    texture_budget(const renderer& r, std::size_t budget_bytes) noexcept
+        : _renderer{r}
+        , _budget{budget_bytes}
+    {}
+
+    texture_budget(const texture_budget&) = delete;
+    auto operator=(const texture_budget&) -> texture_budget& = delete;
+
+    // Registers an image file; nothing is loaded until the first get().
+    auto add(std::string path) -> id
+    {
+        return add_source(std::move(path));
+    }
+
+    // The stream is rewound and decoded on every (re)load, so it must
+    // outlive the budget.
+    auto add(stream& s) -> id
+    {
+        return add_source(&s);
+    }
+
+    auto add(generator g) -> id
+    {
+        return add_source(std::move(g));
+    }
+
+    // Returns the texture, loading it first if needed, and marks it as
+    // drawn in the current frame. The reference stays valid until the
+    // texture is evicted, which cannot happen before the next end_frame().
+    auto get(id i) -> texture_ref
+    {
+        auto& e = _entries[i];
+        e.last_used = _frame;
+        if (!e.loaded) {
+            load(e);
+            e.lru = _lru.insert(_lru.begin(), i);
+            enforce();
+        } else if (e.lru != _lru.begin()) {
+            _lru.splice(_lru.begin(), _lru, e.lru);
+        }
+        return *e.loaded;
+    }
+
+    auto resident(id i) const noexcept -> bool
+    {
+        return _entries[i].loaded.has_value();
+    }
+
+    // Size of the texture when resident, zero otherwise.
+    auto bytes(id i) const noexcept -> std::size_t
+    {
+        return _entries[i].bytes;
+    }
+
+    void end_frame()
+    {
+        ++_frame;
+        enforce();
+    }
+
+    void set_budget(std::size_t budget_bytes)
+    {
+        _budget = budget_bytes;
+        enforce();
+    }
+
+    auto budget() const noexcept -> std::size_t
+    {
+        return _budget;
+    }
+
+    void evict(id i) noexcept
+    {
+        auto& e = _entries[i];
+        if (e.loaded) {
+            unload(e);
+            ++_stats.evictions;
+        }
+    }
+
+    // Evicts every texture, e.g. when the app goes to the background.
+    void evict_all() noexcept
+    {
+        for (auto& e : _entries) {
+            if (e.loaded) {
+                unload(e);
+                ++_stats.evictions;
+            }
+        }
+    }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return _entries.size();
+    }
+
+    auto stats() const noexcept -> const texture_budget_stats&
+    {
+        return _stats;
+    }
+
+    void reset_stats() noexcept
+    {
+        _stats.peak_bytes = _stats.resident_bytes;
+        _stats.evictions = 0;
+        _stats.loads = 0;
+        _stats.total_load_time = std::chrono::nanoseconds{0};
+        _stats.max_load_time = std::chrono::nanoseconds{0};
+    }
+
+private:
+    using source = std::variant<std::string, stream*, generator>;
+
+    struct entry {
+        source origin;
+        std::optional<texture> loaded;
+        std::size_t bytes;
+        u64 last_used;
+        std::list<id>::iterator lru;
+    };
+
+    auto add_source(source origin) -> id
+    {
+        _entries.push_back(entry{std::move(origin), std::nullopt, 0, 0, _lru.end()});
+        return _entries.size() - 1;
+    }
+
+    void load(entry& e)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (const auto path = std::get_if<std::string>(&e.origin)) {
+            e.loaded.emplace(img::load_as_texture(_renderer, path->c_str()));
+        } else if (const auto s = std::get_if<stream*>(&e.origin)) {
+            (*s)->seek(0, RW_SEEK_SET);
+            e.loaded.emplace(_renderer, img::load_as_surface(**s));
+        } else {
+            e.loaded.emplace(std::get<generator>(e.origin)(_renderer));
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        e.bytes = detail::texture_bytes(*e.loaded);
+        _stats.resident_bytes += e.bytes;
+        _stats.peak_bytes = std::max(_stats.peak_bytes, _stats.resident_bytes);
+        ++_stats.resident_count;
+        ++_stats.loads;
+        _stats.total_load_time += elapsed;
+        _stats.max_load_time = std::max(_stats.max_load_time, std::chrono::nanoseconds{elapsed});
+    }
+
+    void unload(entry& e) noexcept
+    {
+        e.loaded.reset();
+        _lru.erase(e.lru);
+        e.lru = _lru.end();
+        _stats.resident_bytes -= e.bytes;
+        --_stats.resident_count;
+        e.bytes = 0;
+    }
+
+    // Evicts from the cold end until the budget holds or only textures
+    // drawn this frame remain.
+    void enforce() noexcept
+    {
+        while (_stats.resident_bytes > _budget && !_lru.empty()) {
+            auto& e = _entries[_lru.back()];
+            if (e.last_used == _frame) break;
+            unload(e);
+            ++_stats.evictions;
+        }
+    }
+
+    const renderer& _renderer;
+    std::size_t _budget;
+    std::vector<entry> _entries;
+    std::list<id> _lru; // most recently drawn first
+    u64 _frame = 0;
+    texture_budget_stats _stats;
+};
+
+} // namespace sdl
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sdlw/blend_mode.hpp>
+#include <sdlw/cpu_info.hpp>
+#include <sdlw/error.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+#include <sdlw/surface.hpp>
+
+namespace sdl {
+
+// The renderer's preferred packed format with or without an alpha channel.
+// Renderers list their formats best first; this is the same choice
+// SDL_CreateTextureFromSurface makes for every upload.
+inline auto native_texture_format(const renderer_info& info, bool alpha) noexcept -> pixel_format_type
+{
+    auto fallback = std::optional<pixel_format_type>{};
+    for (auto i = 0; i < info.num_texture_formats(); ++i) {
+        const auto format = info.texture_format(i);
+        if (is_fourcc(format) || is_indexed(format)) continue;
+        if (is_alpha(format) == alpha) return format;
+        if (!fallback) fallback = format;
+    }
+    return fallback.value_or(pixel_format_type::argb8888);
+}
+
+// Uploads decoded surfaces as static textures in the renderer's native
+// format. submit() hands a surface to the worker threads, which convert it
+// with surface::convert; poll() then creates the textures on the render
+// thread, where the upload is a straight copy. Surfaces with an alpha
+// channel or a color key become blended textures, matching
+// texture(renderer, surface).
+class texture_uploader {
+public:
+    using id = u64;
+
+    explicit texture_uploader(const renderer& r, int worker_count = std::max(cpu_info::cpu_count() - 1, 1))
+        : _renderer{r}
+        , _opaque{native_texture_format(r.info(), false)}
+        , _alpha{native_texture_format(r.info(), true)}
+    {
+        for (auto i = 0; i < std::max(worker_count, 1); ++i) {
+            _workers.emplace_back([this] { work(); });
+        }
+    }
+
+    texture_uploader(const texture_uploader&) = delete;
+    auto operator=(const texture_uploader&) -> texture_uploader& = delete;
+
+    // Pending conversions are finished; their textures are never created.
+    ~texture_uploader()
+    {
+        {
+            const auto lock = std::lock_guard{_mutex};
+            _stopping = true;
+        }
+        _work_ready.notify_all();
+        for (auto& w : _workers) {
+            w.join();
+        }
+    }
+
+    // Queues a surface for conversion. The surface must not be touched by
+    // anyone else until it comes back through poll().
+    auto submit(surface s) -> id
+    {
+        auto i = id{};
+        {
+            const auto lock = std::lock_guard{_mutex};
+            i = _next_id++;
+            _jobs.push_back(job{i, std::move(s)});
+        }
+        _work_ready.notify_one();
+        return i;
+    }
+
+    // Creates a texture for every finished conversion and passes it to
+    // callback(id, expected<texture>). Must run on the render thread.
+    // Returns the number of surfaces handled.
+    template<typename Callback>
+    auto poll(Callback&& callback) -> std::size_t
+    {
+        {
+            const auto lock = std::lock_guard{_mutex};
+            std::swap(_ready, _handoff);
+        }
+        for (auto& j : _handoff) {
+            if (j.failed) {
+                // SDL's error message is per thread; bring the worker's over.
+                set_error("%s", j.message.c_str());
+                callback(j.ticket, expected<texture>{unexpected{error_code{}}});
+            } else {
+                callback(j.ticket, create(j.pixels, j.blended));
+            }
+        }
+        const auto count = _handoff.size();
+        _handoff.clear();
+        return count;
+    }
+
+    // Blocks until every submitted surface has been converted.
+    void wait()
+    {
+        auto lock = std::unique_lock{_mutex};
+        _idle.wait(lock, [this] { return _jobs.empty() && _busy == 0; });
+    }
+
+    // Converts on the calling thread and uploads right away.
+    auto upload(const surface& s) -> texture
+    {
+        const auto& target = format_for(s);
+        const auto blended = &target == &_alpha;
+        auto t = needs_conversion(s, target)
+            ? create(s.convert(pixel_format_ref{target.get_pointer()}), blended)
+            : create(s, blended);
+        if (!t) SDLW_DETAIL_THROW_ERROR();
+        return std::move(*t);
+    }
+
+    auto opaque_format() const noexcept -> pixel_format_type
+    {
+        return _opaque.format();
+    }
+
+    auto alpha_format() const noexcept -> pixel_format_type
+    {
+        return _alpha.format();
+    }
+
+    auto pending() const -> std::size_t
+    {
+        const auto lock = std::lock_guard{_mutex};
+        return _jobs.size() + _busy + _ready.size();
+    }
+
+private:
+    struct job {
+        id ticket;
+        surface pixels;
+        bool blended = false;
+        bool failed = false;
+        std::string message = {};
+    };
+
+    static auto has_color_key(const surface& s) noexcept -> bool
+    {
+        auto key = u32{};
+        return SDL_GetColorKey(s.get_pointer(), &key) == 0;
+    }
+
+    auto format_for(const surface& s) const noexcept -> const pixel_format&
+    {
+        return is_alpha(s.format().format()) || has_color_key(s) ? _alpha : _opaque;
+    }
+
+    // Color keys only turn into transparent pixels during a conversion, so
+    // keyed surfaces are converted even when already in the target format,
+    // as SDL_CreateTextureFromSurface does.
+    static auto needs_conversion(const surface& s, const pixel_format& target) noexcept -> bool
+    {
+        return s.format().format() != target.format() || has_color_key(s);
+    }
+
+    void work()
+    {
+        for (;;) {
+            auto j = job{0, surface{nullptr}};
+            {
+                auto lock = std::unique_lock{_mutex};
+                _work_ready.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+                if (_jobs.empty()) return;
+                j = std::move(_jobs.front());
+                _jobs.pop_front();
+                ++_busy;
+            }
+
+            const auto& target = format_for(j.pixels);
+            j.blended = &target == &_alpha;
+            if (needs_conversion(j.pixels, target)) {
+                if (auto converted = j.pixels.convert(pixel_format_ref{target.get_pointer()}, std::nothrow)) {
+                    j.pixels = std::move(*converted);
+                } else {
+                    j.failed = true;
+                    j.message = SDL_GetError();
+                }
+            }
+
+            {
+                const auto lock = std::lock_guard{_mutex};
+                _ready.push_back(std::move(j));
+                --_busy;
+            }
+            _idle.notify_all();
+        }
+    }
+
+    auto create(const surface& s, bool blended) const noexcept -> expected<texture>
+    {
+        const auto sz = s.size();
+        const auto format = static_cast<u32>(s.format().format());
+        const auto access = static_cast<int>(texture_access::static_);
+        auto t = texture{SDL_CreateTexture(_renderer.get_pointer(), format, access, sz.w, sz.h)};
+        if (!t.get_pointer()) return unexpected{error_code{}};
+        if (const auto result = t.update(rect{0, 0, sz.w, sz.h}, s.pixels(), s.pitch(), std::nothrow); !result) {
+            return unexpected{result.error()};
+        }
+        if (blended) {
+            static_cast<void>(t.set_blend_mode(blend_mode::blend, std::nothrow));
+        }
+        return t;
+    }
+
+    const renderer& _renderer;
+    pixel_format _opaque;
+    pixel_format _alpha;
+
+    std::deque<job> _jobs;
+    std::vector<job> _ready;
+    std::vector<job> _handoff;
+    std::size_t _busy = 0;
+    id _next_id = 0;
+    bool _stopping = false;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _work_ready;
+    std::condition_variable _idle;
+    std::vector<std::thread> _workers;
+};
+
+} // namespace sdl
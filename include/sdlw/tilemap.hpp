@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include <sdlw/blend_mode.hpp>
+#include <sdlw/error.hpp>
+#include <sdlw/events.hpp>
+#include <sdlw/pixels.hpp>
+#include <sdlw/rect.hpp>
+#include <sdlw/render.hpp>
+
+namespace sdl {
+
+// Grid of tiles drawn from a tileset texture whose tiles are laid out left
+// to right, top to bottom. The map is split into square chunks of
+// chunk_tiles tiles; each chunk is baked once into a target texture and
+// drawn with a single copy. Changing a tile only re-bakes its chunk, and
+// chunks are baked lazily, the first time they are visible after a change.
+class tilemap {
+public:
+    static constexpr auto empty = -1;
+
+    tilemap(renderer& r, const texture_ref& tileset, const sdl::size& tile_size, const sdl::size& map_size, int chunk_tiles = 32)
+        : _renderer{r}
+        , _tileset{tileset}
+        , _tile_size{tile_size}
+        , _map_size{map_size}
+        , _chunk_tiles{std::max(chunk_tiles, 1)}
+        , _tiles(static_cast<std::size_t>(map_size.w) * static_cast<std::size_t>(map_size.h), empty)
+    {
+        if (tile_size.w <= 0 || tile_size.h <= 0 || map_size.w < 0 || map_size.h < 0) {
+            set_error("sdl::tilemap: invalid tile or map size");
+            SDLW_DETAIL_THROW_ERROR();
+        }
+        _columns = std::max(tileset.size().w / tile_size.w, 1);
+        _chunks_across = (map_size.w + _chunk_tiles - 1) / _chunk_tiles;
+        _chunks_down = (map_size.h + _chunk_tiles - 1) / _chunk_tiles;
+        _chunks.resize(static_cast<std::size_t>(_chunks_across) * static_cast<std::size_t>(_chunks_down));
+    }
+
+    tilemap(const tilemap&) = delete;
+    auto operator=(const tilemap&) -> tilemap& = delete;
+
+    auto tile(int x, int y) const noexcept -> int
+    {
+        return _tiles[index(x, y)];
+    }
+
+    void set_tile(int x, int y, int tile) noexcept
+    {
+        auto& t = _tiles[index(x, y)];
+        if (t != tile) {
+            t = tile;
+            chunk_at(x, y).dirty = true;
+        }
+    }
+
+    // Sets every tile inside area, given in tiles and clipped to the map.
+    void fill(const rect& area, int tile) noexcept
+    {
+        const auto x0 = std::max(area.x, 0);
+        const auto y0 = std::max(area.y, 0);
+        const auto x1 = std::min(area.x + area.w, _map_size.w);
+        const auto y1 = std::min(area.y + area.h, _map_size.h);
+        for (auto y = y0; y < y1; ++y) {
+            for (auto x = x0; x < x1; ++x) {
+                set_tile(x, y, tile);
+            }
+        }
+    }
+
+    // Replaces the whole map; tiles holds map_size().w * map_size().h ids
+    // in row-major order.
+    void assign(span<const int> tiles) noexcept
+    {
+        const auto count = std::min(static_cast<std::size_t>(tiles.size()), _tiles.size());
+        std::copy_n(tiles.begin(), count, _tiles.begin());
+        invalidate();
+    }
+
+    // Marks every chunk for re-baking, e.g. after the tileset changed.
+    void invalidate() noexcept
+    {
+        for (auto& c : _chunks) {
+            c.dirty = true;
+        }
+    }
+
+    // Chunk textures are lost when the render device is reset and their
+    // contents when render targets are reset.
+    void handle_event(const event& e)
+    {
+        switch (e.type()) {
+        case event_type::render_device_reset:
+            for (auto& c : _chunks) {
+                c.baked.reset();
+            }
+            invalidate();
+            break;
+        case event_type::render_targets_reset: invalidate(); break;
+        default: break;
+        }
+    }
+
+    // Draws the chunks that intersect the current viewport. camera is the
+    // map pixel shown at the viewport's top-left corner. Dirty visible
+    // chunks are baked first, which switches the render target and restores
+    // it afterwards.
+    void draw(const point& camera)
+    {
+        const auto viewport = _renderer.viewport();
+        const auto visible = rect{camera.x, camera.y, viewport.w, viewport.h};
+        const auto chunk_w = _chunk_tiles * _tile_size.w;
+        const auto chunk_h = _chunk_tiles * _tile_size.h;
+        const auto cx0 = std::max(floor_div(visible.x, chunk_w), 0);
+        const auto cy0 = std::max(floor_div(visible.y, chunk_h), 0);
+        const auto cx1 = std::min(floor_div(visible.x + visible.w - 1, chunk_w), _chunks_across - 1);
+        const auto cy1 = std::min(floor_div(visible.y + visible.h - 1, chunk_h), _chunks_down - 1);
+
+        _draw_calls = 0;
+        _chunks_baked = 0;
+        for (auto cy = cy0; cy <= cy1; ++cy) {
+            for (auto cx = cx0; cx <= cx1; ++cx) {
+                auto& c = _chunks[static_cast<std::size_t>(cy * _chunks_across + cx)];
+                if (c.dirty || !c.baked) {
+                    bake(c, cx, cy);
+                }
+                const auto sz = c.baked->size();
+                const auto dst = rect{cx * chunk_w - camera.x, cy * chunk_h - camera.y, sz.w, sz.h};
+                _renderer.copy(*c.baked, nullptr, &dst);
+                ++_draw_calls;
+            }
+        }
+    }
+
+    auto map_size() const noexcept -> sdl::size
+    {
+        return _map_size;
+    }
+
+    auto tile_size() const noexcept -> sdl::size
+    {
+        return _tile_size;
+    }
+
+    auto chunk_tiles() const noexcept -> int
+    {
+        return _chunk_tiles;
+    }
+
+    // Copies issued and chunks baked by the last draw().
+    auto draw_calls() const noexcept -> int
+    {
+        return _draw_calls;
+    }
+
+    auto chunks_baked() const noexcept -> int
+    {
+        return _chunks_baked;
+    }
+
+private:
+    struct chunk {
+        std::optional<texture> baked;
+        bool dirty = true;
+    };
+
+    static auto floor_div(int a, int b) noexcept -> int
+    {
+        return a / b - (a % b != 0 && (a < 0) != (b < 0));
+    }
+
+    auto index(int x, int y) const noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(y) * static_cast<std::size_t>(_map_size.w) + static_cast<std::size_t>(x);
+    }
+
+    auto chunk_at(int x, int y) noexcept -> chunk&
+    {
+        const auto cx = x / _chunk_tiles;
+        const auto cy = y / _chunk_tiles;
+        return _chunks[static_cast<std::size_t>(cy * _chunks_across + cx)];
+    }
+
+    void bake(chunk& c, int cx, int cy)
+    {
+        const auto x0 = cx * _chunk_tiles;
+        const auto y0 = cy * _chunk_tiles;
+        const auto tiles_w = std::min(_chunk_tiles, _map_size.w - x0);
+        const auto tiles_h = std::min(_chunk_tiles, _map_size.h - y0);
+        if (!c.baked) {
+            const auto sz = sdl::size{tiles_w * _tile_size.w, tiles_h * _tile_size.h};
+            c.baked.emplace(_renderer, pixel_format_type::argb8888, texture_access::target, sz);
+            c.baked->set_blend_mode(blend_mode::blend);
+        }
+
+        const auto previous_target = _renderer.target();
+        const auto previous_viewport = _renderer.viewport();
+        const auto previous_clip = _renderer.is_clip_enabled() ? std::optional{_renderer.clip()} : std::nullopt;
+        const auto previous_color = _renderer.draw_color();
+        const auto tileset_mode = _tileset.blend_mode();
+
+        // Tiles are copied without blending so the chunk keeps their alpha.
+        _renderer.set_target(*c.baked);
+        _renderer.set_draw_color(color{0, 0, 0, 0});
+        _renderer.clear();
+        _tileset.set_blend_mode(blend_mode::none);
+        for (auto y = 0; y < tiles_h; ++y) {
+            for (auto x = 0; x < tiles_w; ++x) {
+                const auto t = tile(x0 + x, y0 + y);
+                if (t < 0) continue;
+                const auto src = rect{(t % _columns) * _tile_size.w, (t / _columns) * _tile_size.h, _tile_size.w, _tile_size.h};
+                const auto dst = rect{x * _tile_size.w, y * _tile_size.h, _tile_size.w, _tile_size.h};
+                _renderer.copy(_tileset, &src, &dst);
+            }
+        }
+        _tileset.set_blend_mode(tileset_mode);
+
+        _renderer.set_target(previous_target);
+        _renderer.set_viewport(previous_viewport);
+        if (previous_clip) _renderer.set_clip(*previous_clip);
+        _renderer.set_draw_color(previous_color);
+
+        c.dirty = false;
+        ++_chunks_baked;
+    }
+
+    renderer& _renderer;
+    texture_ref _tileset;
+    sdl::size _tile_size;
+    sdl::size _map_size;
+    int _chunk_tiles;
+    int _columns = 1;
+    int _chunks_across = 0;
+    int _chunks_down = 0;
+    std::vector<int> _tiles;
+    std::vector<chunk> _chunks;
+    int _draw_calls = 0;
+    int _chunks_baked = 0;
+};
+
+} // namespace sdl
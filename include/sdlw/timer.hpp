@@ -37,7 +37,7 @@ inline auto add_timer(clock::duration interval, timer_callback* callback) -> tim
         return func(clock::duration{interval}).count();
     };
     const auto result = SDL_AddTimer(interval.count(), sdl_timer_callback, reinterpret_cast<void*>(callback));
-    if (result == 0) throw error{};
+    if (result == 0) SDLW_DETAIL_THROW_ERROR();
     return result;
 }
 
@@ -49,7 +49,7 @@ auto add_timer(clock::duration interval, Callable& cb) -> timer_id {
         return func(clock::duration{interval}).count();
     };
     const auto result = SDL_AddTimer(interval.count(), sdl_timer_callback, &cb);
-    if (result == 0) throw error{};
+    if (result == 0) SDLW_DETAIL_THROW_ERROR();
     return result;
 }
 
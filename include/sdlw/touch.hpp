@@ -52,7 +52,7 @@ inline int num_touch_devices() noexcept
 inline touch_id get_touch_device(int device_index)
 {
     if (const auto result = SDL_GetTouchDevice(device_index); result == 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return touch_id(result);
     }
@@ -62,7 +62,7 @@ inline int num_touch_fingers(touch_id id)
 {
     const auto result = SDL_GetNumTouchFingers(static_cast<SDL_TouchID>(id));
     if (result == 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return result;
     }
@@ -73,7 +73,7 @@ inline finger get_touch_finger(touch_id id, int finger_index)
     if (const auto fing = SDL_GetTouchFinger(SDL_TouchID(id), finger_index)) {
         return finger(*fing);
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -18,7 +18,7 @@ struct subsystem {
     subsystem()
     {
         if (TTF_Init() < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -73,13 +73,13 @@ public:
     font(const char* filename, int ptsize)
         : _font{TTF_OpenFont(filename, ptsize)}
     {
-        if (!_font) throw error{};
+        if (!_font) SDLW_DETAIL_THROW_ERROR();
     }
 
     font(const char* filename, int ptsize, long index)
         : _font{TTF_OpenFontIndex(filename, ptsize, index)}
     {
-        if (!_font) throw error{};
+        if (!_font) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto style() const noexcept -> sdl::ttf::style
@@ -179,7 +179,7 @@ public:
         if (TTF_GlyphMetrics(pfont, ch, minx, maxx, miny, maxy, adv) == 0) {
             return metrics;
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 };
@@ -190,7 +190,7 @@ inline auto text_render_size(const font& f, const char* text) -> size
     if (TTF_SizeText(f.get_pointer(), text, &size.w, &size.h) == 0) {
         return size;
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -200,7 +200,7 @@ inline auto solid_text_render(const font& f, const char* text, color fg_color) -
     if (const auto psurface = TTF_RenderText_Solid(pfont, text, fg_color)) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -210,7 +210,7 @@ inline auto solid_utf8_render(const font& f, const char* text, color fg_color) -
     if (const auto psurface = TTF_RenderUTF8_Solid(pfont, text, fg_color)) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -220,7 +220,7 @@ inline auto shaded_text_render(const font& f, const char* text, color fg, color
     if (const auto psurface = TTF_RenderText_Shaded(pfont, text, fg, bg)) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -230,7 +230,7 @@ inline auto shaded_utf8_render(const font& f, const char* text, color fg, color
     if (const auto psurface = TTF_RenderUTF8_Shaded(pfont, text, fg, bg)) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -240,7 +240,7 @@ inline auto blended_text_render(const font& f, const char* text, color fg_color)
     if (const auto psurface = TTF_RenderText_Blended(pfont, text, fg_color)) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -250,7 +250,37 @@ inline auto blended_utf8_render(const font& f, const char* text, color fg_color)
     if (const auto psurface = TTF_RenderUTF8_Blended(pfont, text, fg_color)) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto solid_glyph_render(const font& f, u16 ch, color fg_color) -> surface
+{
+    const auto pfont = f.get_pointer();
+    if (const auto psurface = TTF_RenderGlyph_Solid(pfont, ch, fg_color)) {
+        return surface{psurface};
+    } else {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto shaded_glyph_render(const font& f, u16 ch, color fg, color bg) -> surface
+{
+    const auto pfont = f.get_pointer();
+    if (const auto psurface = TTF_RenderGlyph_Shaded(pfont, ch, fg, bg)) {
+        return surface{psurface};
+    } else {
+        SDLW_DETAIL_THROW_ERROR();
+    }
+}
+
+inline auto blended_glyph_render(const font& f, u16 ch, color fg_color) -> surface
+{
+    const auto pfont = f.get_pointer();
+    if (const auto psurface = TTF_RenderGlyph_Blended(pfont, ch, fg_color)) {
+        return surface{psurface};
+    } else {
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -262,7 +292,7 @@ inline auto blended_wrapped_text_render(const font& f, const char* txt, color fg
     if (psurface) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -274,7 +304,7 @@ inline auto blended_wrapped_utf8_render(const font& f, const char* txt, color fg
     if (psurface) {
         return surface{psurface};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -182,13 +182,13 @@ public:
     window(const char* title, const rect& bounds, window::flags flags)
         : window{SDL_CreateWindow(title, bounds.x, bounds.y, bounds.w, bounds.h, static_cast<u32>(flags))}
     {
-        if (!_window) throw error{};
+        if (!_window) SDLW_DETAIL_THROW_ERROR();
     }
 
     explicit window(void* native_window_data)
         : window{SDL_CreateWindowFrom(native_window_data)}
     {
-        if (!_window) throw error{};
+        if (!_window) SDLW_DETAIL_THROW_ERROR();
     }
 
     auto flags() const noexcept -> enum window::flags
@@ -246,7 +246,7 @@ public:
     {
         auto bsizes = std::array<int, 4>{};
         if (SDL_GetWindowBordersSize(get_pointer(), &bsizes[0], &bsizes[1], &bsizes[2], &bsizes[3]) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return bsizes;
         }
@@ -306,7 +306,7 @@ public:
         if (const auto ptr = SDL_GetWindowSurface(get_pointer())) {
             return surface_ref{ptr};
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -316,14 +316,14 @@ public:
         if (SDL_GetWindowOpacity(get_pointer(), &opacity) == 0) {
             return opacity;
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
     void set_opacity(float opacity)
     {
         if (SDL_SetWindowOpacity(get_pointer(), opacity) == 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -333,7 +333,7 @@ public:
         if (SDL_GetWindowDisplayMode(get_pointer(), &mode) == 0) {
             return sdl::display_mode(mode);
         } else {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -341,7 +341,7 @@ public:
     {
         const auto pmode = reinterpret_cast<const SDL_DisplayMode*>(mode);
         if (SDL_SetWindowDisplayMode(get_pointer(), pmode) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -349,7 +349,7 @@ public:
     {
         const auto index = SDL_GetWindowDisplayIndex(get_pointer());
         if (index < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return index;
         }
@@ -359,7 +359,7 @@ public:
     {
         const auto format = SDL_GetWindowPixelFormat(get_pointer());
         if (format == SDL_PIXELFORMAT_UNKNOWN) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         } else {
             return static_cast<sdl::pixel_format_type>(format);
         }
@@ -379,7 +379,7 @@ public:
     {
         const auto sdl_mode = static_cast<u32>(mode);
         if (SDL_SetWindowFullscreen(get_pointer(), sdl_mode) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -406,14 +406,14 @@ public:
     void set_input_focus()
     {
         if (SDL_SetWindowInputFocus(get_pointer()) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
     void update_surface()
     {
         if (SDL_UpdateWindowSurface(get_pointer()) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -422,7 +422,7 @@ public:
         const auto pwin = get_pointer();
         const auto sz = static_cast<int>(areas.size());
         if (SDL_UpdateWindowSurfaceRects(pwin, areas.data(), sz) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -436,7 +436,7 @@ public:
     void set_modal(const window& modal)
     {
         if (SDL_SetWindowModalFor(modal.get_pointer(), get_pointer()) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -478,7 +478,7 @@ void window::set_hit_test(HitTest& ht)
         return static_cast<SDL_HitTestResult>(result);
     };
     if (SDL_SetWindowHitTest(get_pointer(), sdl_callback, &ht) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -490,7 +490,7 @@ inline void window::set_hit_test(hit_test_result (*ht)(window_ref, const point&)
         return static_cast<SDL_HitTestResult>(result);
     };
     if (SDL_SetWindowHitTest(get_pointer(), fp_sdl_callback, reinterpret_cast<void*>(ht)) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -511,7 +511,7 @@ inline auto closest_display_mode(int display_index, const display_mode& m) -> di
     if (SDL_GetClosestDisplayMode(display_index, pmode, &closest)) {
         return display_mode{closest};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -521,7 +521,7 @@ inline auto current_display_mode(int display_index) -> display_mode
     if (SDL_GetCurrentDisplayMode(display_index, &current) == 0) {
         return display_mode{current};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -531,7 +531,7 @@ inline auto desktop_display_mode(int display_index) -> display_mode
     if (SDL_GetDesktopDisplayMode(display_index, &desktop) == 0) {
         return display_mode{desktop};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -541,7 +541,7 @@ inline auto display_bounds(int display_index) -> rect
     if (SDL_GetDisplayBounds(display_index, &bounds) == 0) {
         return bounds;
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -553,7 +553,7 @@ inline auto display_dpi(int display_index) -> std::array<float, 3>
     if (SDL_GetDisplayDPI(display_index, &ddpi, &hdpi, &vdpi) == 0) {
         return std::array{ddpi, hdpi, vdpi};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -563,7 +563,7 @@ inline auto get_display_mode(int display_index, int mode_index) -> display_mode
     if (SDL_GetDisplayMode(display_index, mode_index, &m) == 0) {
         return display_mode{m};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -578,14 +578,14 @@ inline auto display_usable_bounds(int display_index) -> rect
     if (SDL_GetDisplayUsableBounds(display_index, &r) == 0) {
         return r;
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
 inline auto num_display_modes(int display_index) -> int
 {
     if (const auto count = SDL_GetNumDisplayModes(display_index); count < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return count;
     }
@@ -594,7 +594,7 @@ inline auto num_display_modes(int display_index) -> int
 inline auto num_video_displays() -> int
 {
     if (const auto cnt = SDL_GetNumVideoDisplays(); cnt < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return cnt;
     }
@@ -608,7 +608,7 @@ inline auto display_brightness(const window& win) noexcept -> float
 inline void set_display_brightness(const window& win, float brightness)
 {
     if (SDL_SetWindowBrightness(win.get_pointer(), brightness) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -618,7 +618,7 @@ inline void get_display_gamma_ramp(const window& win, span<u16, 256> red, span<u
     const auto g = green.data();
     const auto b = blue.data();
     if (SDL_GetWindowGammaRamp(win.get_pointer(), r, g, b) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -628,7 +628,7 @@ inline void set_display_gamma_ramp(const window& win, span<const u16, 256> red,
     const auto g = green.data();
     const auto b = blue.data();
     if (SDL_SetWindowGammaRamp(win.get_pointer(), r, g, b) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -668,7 +668,7 @@ struct video_subsystem {
     video_subsystem(const char* driver_name)
     {
         if (SDL_VideoInit(driver_name) < 0) {
-            throw error{};
+            SDLW_DETAIL_THROW_ERROR();
         }
     }
 
@@ -689,7 +689,7 @@ public:
     explicit context(window& w)
         : context{SDL_GL_CreateContext(w.get_pointer())}
     {
-        if (!_context) throw error{};
+        if (!_context) SDLW_DETAIL_THROW_ERROR();
     }
 
 protected:
@@ -755,7 +755,7 @@ inline auto attribute(attr a) -> int
 {
     auto result = int{};
     if (SDL_GL_GetAttribute(static_cast<SDL_GLattr>(a), &result) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     } else {
         return result;
     }
@@ -766,7 +766,7 @@ inline auto current_context() -> context_ref
     if (const auto p = SDL_GL_GetCurrentContext()) {
         return context_ref{p};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -775,7 +775,7 @@ inline auto current_window() -> window_ref
     if (const auto p = SDL_GL_GetCurrentWindow()) {
         return window_ref{p};
     } else {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -799,14 +799,14 @@ inline auto swap_interval() noexcept -> int
 inline void load_library(const char* path)
 {
     if (SDL_GL_LoadLibrary(path) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
 inline void make_current(const window& w, context_ref c)
 {
     if (SDL_GL_MakeCurrent(w.get_pointer(), c.get_pointer()) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -819,14 +819,14 @@ template<typename IntegerOrEnum>
 void set_attribute(attr a, IntegerOrEnum value)
 {
     if (SDL_GL_SetAttribute(static_cast<SDL_GLattr>(a), static_cast<int>(value)) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
 inline void set_swap_interval(int interval)
 {
     if (SDL_GL_SetSwapInterval(interval) < 0) {
-        throw error{};
+        SDLW_DETAIL_THROW_ERROR();
     }
 }
 
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <sdlw/cpu_info.hpp>
+#include <sdlw/types.hpp>
+
+namespace sdl {
+
+// Fixed set of threads for splitting one job into independent pieces. The
+// calling thread works on the job too, so a pool of n threads starts n - 1
+// workers. Jobs run one at a time; a second caller waits for the first.
+class worker_pool {
+public:
+    explicit worker_pool(int thread_count = cpu_info::cpu_count())
+    {
+        for (auto i = 1; i < thread_count; ++i) {
+            _workers.emplace_back([this] { work(); });
+        }
+    }
+
+    worker_pool(const worker_pool&) = delete;
+    auto operator=(const worker_pool&) -> worker_pool& = delete;
+
+    ~worker_pool()
+    {
+        {
+            const auto lock = std::lock_guard{_mutex};
+            _stopping = true;
+        }
+        _job_ready.notify_all();
+        for (auto& w : _workers) {
+            w.join();
+        }
+    }
+
+    // Threads working on a job, the caller included.
+    auto thread_count() const noexcept -> int
+    {
+        return static_cast<int>(_workers.size()) + 1;
+    }
+
+    // Calls task(i) once for every i in [0, count), in no particular order,
+    // and returns when all calls have returned. task must not throw.
+    template<typename Task>
+    void for_each(int count, Task&& task)
+    {
+        if (count <= 0) return;
+        if (_workers.empty() || count == 1) {
+            for (auto i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        const auto job_lock = std::lock_guard{_job_mutex};
+        {
+            const auto lock = std::lock_guard{_mutex};
+            _task = const_cast<void*>(static_cast<const void*>(&task));
+            _invoke = [](void* t, int i) { (*static_cast<std::remove_reference_t<Task>*>(t))(i); };
+            _count = count;
+            _next.store(0, std::memory_order_relaxed);
+            _running = _workers.size();
+            ++_generation;
+        }
+        _job_ready.notify_all();
+        run();
+
+        // Every worker checks in, even with nothing left to take, so none
+        // can still be looking at this task when the next one starts.
+        auto lock = std::unique_lock{_mutex};
+        _job_done.wait(lock, [this] { return _running == 0; });
+    }
+
+private:
+    void run() noexcept
+    {
+        for (auto i = _next.fetch_add(1); i < _count; i = _next.fetch_add(1)) {
+            _invoke(_task, i);
+        }
+    }
+
+    void work()
+    {
+        auto seen = u64{0};
+        for (;;) {
+            {
+                auto lock = std::unique_lock{_mutex};
+                _job_ready.wait(lock, [&] { return _stopping || _generation != seen; });
+                if (_stopping) return;
+                seen = _generation;
+            }
+            run();
+            {
+                const auto lock = std::lock_guard{_mutex};
+                if (--_running == 0) _job_done.notify_one();
+            }
+        }
+    }
+
+    void* _task = nullptr;
+    void (*_invoke)(void*, int) = nullptr;
+    int _count = 0;
+    std::atomic<int> _next{0};
+    std::size_t _running = 0;
+    u64 _generation = 0;
+    bool _stopping = false;
+
+    std::mutex _job_mutex;
+    std::mutex _mutex;
+    std::condition_variable _job_ready;
+    std::condition_variable _job_done;
+    std::vector<std::thread> _workers;
+};
+
+} // namespace sdl